@@ -41,6 +41,8 @@ sub new {
     my $self = {defines => {},
 		incdir => ['.', ],
 		includes => {},
+		define_uses => {},
+		define_uses_inclusive => {},
 		module_dir => ['.', ],
 		libext => ['.v', ],
 		library => [ ],
@@ -346,6 +348,30 @@ sub includes {
     return $self->{includes};
 }
 
+sub define_uses {
+    my $self = shift;
+    $self->_define_uses_merge($self->{define_uses}, @_) if @_;
+    return $self->{define_uses};
+}
+
+sub define_uses_inclusive {
+    my $self = shift;
+    $self->_define_uses_merge($self->{define_uses_inclusive}, @_) if @_;
+    return $self->{define_uses_inclusive};
+}
+
+sub _define_uses_merge {
+    my $self = shift;
+    my $hash = shift;
+    my $filename = shift;
+    my $uses = shift;
+    my $ent = ($hash->{$filename} ||= {ifdef=>{}, value=>{}, write=>{}, undefineall=>0});
+    foreach my $kind (qw(ifdef value write)) {
+	$ent->{$kind}{$_} = 1 foreach @{$uses->{$kind} || []};
+    }
+    $ent->{undefineall} = 1 if $uses->{undefineall};
+}
+
 #######################################################################
 # Utility functions
 
@@ -729,6 +755,24 @@ should not be removed by `undefineall.
 
 Return sorted list of all define names that currently exist.
 
+=item $self->define_uses
+
+Returns reference to hash by filename of the defines each file consulted or
+changed, for deciding which files need reprocessing when a define changes.
+Only filled in when Verilog::Preproc's define_uses option is set.  Each
+hash value is a hash with "ifdef", a hash of defines whose existence was
+tested by `ifdef, `ifndef, `elsif or an include guard; "value", a hash of
+defines whose value was substituted; "write", a hash of defines set by
+`define or `undef; and "undefineall", true if `undefineall was used.  Only
+uses in the file itself are included, not those in files it includes.  With
+two arguments, merges in the given filename's uses, in the form returned by
+Verilog::Preproc's define_uses.
+
+=item $self->define_uses_inclusive
+
+As with define_uses, but for each top level file read, and including the
+uses in every file it included.
+
 =item $self->defparams($token)
 
 This method returns the parameter list of the define.  This will be defined,
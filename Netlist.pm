@@ -40,8 +40,11 @@ sub new {
  		preproc => 'Verilog::Preproc',
 		parser => 'Verilog::Netlist::File::Parser',
 		remove_defines_without_tick => 0,   # Overriden in SystemC::Netlist
+		#cache_dir => undef,
+		#define_uses => 0,
 		#include_open_nonfatal => 0,
 		#keep_comments => 0,
+		#pipeline => 0,
 		#synthesis => 0,
 		#use_pinselects => 0,
 		use_vars => 1,
@@ -323,6 +326,13 @@ sub read_verilog_file {
     return $fileref;
 }
 
+sub read_files {
+    my $self = shift;
+    Verilog::Netlist::File::read_files
+	(netlist=>$self,
+	 @_);
+}
+
 sub read_libraries {
     my $self = shift;
     if ($self->{options}) {
@@ -483,6 +493,18 @@ with the following parameters:
 
 =over 8
 
+=item cache_dir => $directory
+
+Store the preprocessed output of each file read in the given directory, and
+reuse it when the same file is read again with the same options, include
+files and defines.  See OUTPUT CACHE in L<Verilog::Preproc>.  The
+cache_size option is passed on the same way.
+
+=item define_uses => $true_or_false
+
+Record which defines each file consulted or changed into the options
+object's define_uses and define_uses_inclusive.  See L<Verilog::Getopt>.
+
 =item implicit_wires_ok => $true_or_false
 
 Indicates whether to allow undeclared wires to be used.
@@ -523,6 +545,11 @@ files.
 
 The name of the parser class. Defaults to "Verilog::Netlist::File::Parser".
 
+=item pipeline => $true_or_false
+
+With pipeline set, preprocess each file on a separate thread while it is
+being parsed.  See the pipeline option of L<Verilog::Preproc>.
+
 =item preproc => $package_name
 
 The name of the preprocessor class. Defaults to "Verilog::Preproc".
@@ -661,6 +688,15 @@ Generally called as $netlist->read_file.  Pass a hash of parameters.  Reads
 the filename=> parameter, parsing all instantiations, ports, and signals,
 and creating Verilog::Netlist::Module structures.
 
+=item $netlist->read_files( filenames=>[$name,...], threads=>$n)
+
+Reads each of the given Verilog files in order, as if read_file were
+called on each.  With threads greater than one, up to that many files are
+preprocessed ahead on other threads while earlier files are parsed.  A file
+read ahead whose preprocessing depended on a define that an earlier file
+changed is preprocessed again, so the results are the same as reading the
+files one at a time.
+
 =item $netlist->read_libraries()
 
 Read any libraries specified in the options=> argument passed with the
@@ -46,6 +46,8 @@ sub new {
 
     my $preproc_class = $params{preproc};
     delete $params{preproc}; # Remove as preproc doesn't need passing down to Preprocessor
+    my $preproc = $params{_preproc};  # Already reading the file, from read_files
+    delete $params{_preproc};
 
     # A new file; make new information
     $params{fileref} or die "%Error: No fileref parameter?";
@@ -59,28 +61,47 @@ sub new {
 				     symbol_table => $params{netlist}->{symbol_table},
 				     );
 
+    if (!$preproc) {
+	$preproc = _new_preproc(fileref => $params{fileref},
+				preproc => $preproc_class,
+				metacomment => $params{metacomment});
+	$preproc->open($params{filename});
+    }
+    $parser->parse_preproc_file($preproc);
+    return $parser;
+}
+
+sub _new_preproc {
+    # Create the preprocessor for a file, not yet opened
+    my %params = (@_);	# fileref=>, preproc=>, metacomment=>
+    my $netlist = $params{fileref}->netlist;
     my @opt;
-    push @opt, (options=>$params{netlist}{options}) if $params{netlist}{options};
+    push @opt, (options=>$netlist->{options}) if $netlist->{options};
     my $meta = $params{metacomment};
     if ($meta) {
 	die "%Error: 'metacomment' arg of Netlist or read_file() must be a hash,"
 	    unless (ref($meta) eq 'HASH');
 	push @opt, metacomments=>[ grep({ $meta->{$_} } keys %$meta) ];
-	push @opt, keep_comments=>($params{netlist}{keep_comments} || 1);
-    } elsif ($params{netlist}{keep_comments}) {
-	push @opt, keep_comments=>$params{netlist}{keep_comments};
+	push @opt, keep_comments=>($netlist->{keep_comments} || 1);
+    } elsif ($netlist->{keep_comments}) {
+	push @opt, keep_comments=>$netlist->{keep_comments};
     } else {
 	push @opt, keep_comments=>0;
     }
     push @opt, keep_whitespace=>1;  # So we don't loose newlines
-    push @opt, include_open_nonfatal=>1 if $params{netlist}{include_open_nonfatal};
-    push @opt, synthesis=>1 if $params{netlist}{synthesis};
-    my $preproc = $preproc_class->new(@opt,
-				      parent => $params{fileref});
+    push @opt, include_open_nonfatal=>1 if $netlist->{include_open_nonfatal};
+    push @opt, synthesis=>1 if $netlist->{synthesis};
+    push @opt, native_defines=>1;
+    push @opt, native_file_path=>1;
+    push @opt, pipeline=>1 if $netlist->{pipeline};
+    push @opt, line_map=>1;
+    push @opt, cache_dir=>$netlist->{cache_dir} if $netlist->{cache_dir};
+    push @opt, cache_size=>$netlist->{cache_size} if $netlist->{cache_size};
+    push @opt, define_uses=>1 if $netlist->{define_uses};
+    my $preproc = $params{preproc}->new(@opt,
+					parent => $params{fileref});
     $params{fileref}->preproc($preproc);
-    $preproc->open($params{filename});
-    $parser->parse_preproc_file($preproc);
-    return $parser;
+    return $preproc;
 }
 
 sub contassign {
@@ -445,7 +466,8 @@ sub read {
     my $filename = $params{filename} or croak "%Error: ".__PACKAGE__."::read_file (filename=>) parameter required, stopped";
     my $netlist = $params{netlist} or croak("Call Verilog::Netlist::read_file instead,");
 
-    my $filepath = $netlist->resolve_filename($filename, $params{lookup_type});
+    my $fileref = $params{_fileref};  # Made by read_files
+    my $filepath = $fileref ? $fileref->name : $netlist->resolve_filename($filename, $params{lookup_type});
     if (!$filepath) {
 	if ($params{error_self}) { $params{error_self}->error("Cannot find $filename\n"); }
 	elsif (!defined $params{error_self}) { die "%Error: Cannot find $filename\n"; }  # 0=suppress error
@@ -453,9 +475,9 @@ sub read {
     }
     print __PACKAGE__."::read_file $filepath\n" if $Verilog::Netlist::Debug;
 
-    my $fileref = $netlist->new_file(name=>$filepath,
-				     is_libcell=>$params{is_libcell}||0,
-				     );
+    $fileref ||= $netlist->new_file(name=>$filepath,
+				    is_libcell=>$params{is_libcell}||0,
+				    );
 
     my $keep_cmt = ($params{keep_comments} || $netlist->{keep_comments});
     my $parser_class = ($params{parser} || $netlist->{parser});
@@ -469,6 +491,7 @@ sub read {
 	  use_pinselects => ($params{use_pinselects} || $netlist->{use_pinselects}),
 	  use_protected => 0,
 	  preproc => ($params{preproc} || $netlist->{preproc}),
+	  _preproc => $params{_preproc},
 	  # Callbacks we need; disable unused for speed
 	  use_cb_attribute => 1,
 	  use_cb_comment => $keep_cmt,
@@ -481,6 +504,43 @@ sub read {
     return $fileref;
 }
 
+sub read_files {
+    my %params = (threads => 1,
+		  lookup_type => 'module',
+		  @_);	# netlist=>, filenames=>, per-file options as for read
+    my $netlist = $params{netlist} or croak("Call Verilog::Netlist::read_files instead,");
+    my $filenames = $params{filenames} or croak "%Error: ".__PACKAGE__."::read_files (filenames=>) parameter required, stopped";
+    my %filerefs;  # Files made for preprocessors reading ahead
+    Verilog::Preproc::_lookahead_each
+	(filenames => $filenames,
+	 threads => $params{threads},
+	 new => sub {
+	     my $filename = shift;
+	     return undef if $filerefs{$filename};  # Listed twice
+	     my $filepath = $netlist->resolve_filename($filename, $params{lookup_type})
+		 or return undef;  # read() will report it
+	     my $fileref = $netlist->new_file(name=>$filepath,
+					      is_libcell=>$params{is_libcell}||0,
+					      );
+	     $filerefs{$filename} = $fileref;
+	     my $pp = Verilog::Netlist::File::Parser::_new_preproc
+		 (fileref => $fileref,
+		  preproc => ($params{preproc} || $netlist->{preproc}),
+		  metacomment => ($params{metacomment} || $netlist->{metacomment}));
+	     # Text read ahead must go straight to the parser
+	     my $parser_class = ($params{parser} || $netlist->{parser});
+	     return $parser_class->_parse_preproc_direct_ok($pp) ? $pp : undef;
+	 },
+	 each => sub {
+	     my ($filename, $pp) = @_;
+	     Verilog::Netlist::File::read
+		 (%params,
+		  filename => $filename,
+		  _fileref => delete $filerefs{$filename},
+		  _preproc => $pp);
+	 });
+}
+
 sub link {
     # For backward compatibility for SystemC child class, call _link
     $_[0]->_link(@_);
@@ -43,6 +43,11 @@ bootstrap Verilog::Parser;
 # sub _use_cb (class, name, flag)
 # sub parse (class)
 # sub eof (class)
+# sub _incremental (class, flag)
+# sub stats (class)
+# sub _parse_preproc (class, text_source)
+# sub _symbol_table_export (class, avp)
+# sub _symbol_table_exists (class, name)
 # sub filename (class, [setit])
 # sub lineno (class, [setit])
 # sub unreadback (class, [setit])
@@ -54,12 +59,13 @@ bootstrap Verilog::Parser;
 sub new {
     my $class = shift;  $class = ref $class if ref $class;
     my $self = {_sigparser=>0,
-		symbol_table=>[],	# .xs will init further for us
+		symbol_table=>[],	# .xs attaches the symbol table to this array
 		use_vars => 1,
 		use_unreadback => 1,   # Backward compatibility
 		use_protected => 1,   # Backward compatibility
 		use_pinselects => 0,   # Backward compatibility
 		use_std => undef,	# Undef = silent
+		incremental => 0,
 		#use_cb_{callback-name} => 0/1
 		#
 		#_debug		# Don't set, use debug() accessor to change level
@@ -75,6 +81,7 @@ sub new {
 		$self->{use_protected},
 		$self->{use_pinselects},  # Undocumented as for use in SigParser only
 		);
+    $self->_incremental(1) if $self->{incremental};
 
     $self->{use_cb_contassign} = $self->{use_vars} if !exists $self->{use_cb_contassign};
     $self->{use_cb_defparam} = $self->{use_vars} if !exists $self->{use_cb_defparam};
@@ -123,6 +130,13 @@ sub fileline {
 
 sub line { return lineno(@_); }  # Old, now undocumented
 
+sub symbol_table {
+    my $self = shift;
+    # The symbols are kept in C++, and only copied into the array when asked for
+    $self->_symbol_table_export($self->{symbol_table});
+    return $self->{symbol_table};
+}
+
 #######################################################################
 #### Methods
 
@@ -134,7 +148,7 @@ sub reset {
 sub std {
     my $self = shift;
     my $quiet = !defined $self->{use_std} && $self->{_sigparser};
-    if (!$self->{symbol_table}[2]->{std}  # Not in the symbol table yet
+    if (!$self->_symbol_table_exists("std")  # Not in the symbol table yet
 	&& ($self->{use_std} || $quiet)
 	) {
 	print "Including std::\n" if $self->{_debug};
@@ -182,6 +196,12 @@ sub parse_preproc_file {
     ref($pp) or croak "%Error: not passed a Verilog::Preproc object";
     $self->reset();
 
+    if ($self->_parse_preproc_direct_ok($pp)) {
+	# Lexer pulls text straight from the preprocessor, without
+	# copying through Perl or buffering the whole input
+	$self->_parse_preproc($pp->_text_source);
+	return $self;
+    }
     # Chunk size of ~32K determined experimentally with t/49_largeish.t
     while (defined(my $text = $pp->getall(31*1024))) {
 	$self->parse($text);
@@ -190,6 +210,50 @@ sub parse_preproc_file {
     return $self;
 }
 
+sub parse_files {
+    # Preprocess and parse each file
+    my $self = shift;
+    my $filenames = shift;
+    my %params = (threads => 1,
+		  preproc => "Verilog::Preproc",
+		  native_defines => 1,
+		  @_);  # Others are passed to the preprocessor's new()
+    (ref $filenames eq 'ARRAY') or croak 'usage: $parser->parse_files([filenames...], threads=>N)';
+    my $threads = delete $params{threads};
+    my $pp_class = delete $params{preproc};
+    require Verilog::Preproc;
+    # All files share one set of defines
+    $params{options} ||= Verilog::Getopt->new;
+    Verilog::Preproc::_lookahead_each
+	(filenames => $filenames,
+	 threads => $threads,
+	 new => sub {
+	     my $pp = $pp_class->new(%params);
+	     # Text read ahead must go straight to the parser
+	     return $self->_parse_preproc_direct_ok($pp) ? $pp : undef;
+	 },
+	 each => sub {
+	     my ($filename, $pp) = @_;
+	     if (!$pp) {
+		 $pp = $pp_class->new(%params);
+		 $pp->open($filename) or return;
+	     }
+	     $self->parse_preproc_file($pp);
+	 });
+    return $self;
+}
+
+sub _parse_preproc_direct_ok {
+    my $self = shift;
+    my $pp = shift;
+    # Text can only bypass Perl if nobody overrides the methods it would use
+    return (UNIVERSAL::isa($pp, "Verilog::Preproc")
+	    && $pp->{_cthis}
+	    && ($pp->can("getall")||0) == \&Verilog::Preproc::getall
+	    && ($self->can("parse")||0) == \&Verilog::Parser::parse
+	    && ($self->can("eof")||0) == \&Verilog::Parser::eof);
+}
+
 ######################################################################
 #### Called by the parser
 
@@ -316,11 +380,20 @@ parser to filter out such errors if it cares.
 
 Create a new Parser.
 
+Adding "incremental => 1" will lex and parse the text of each parse call
+as it is passed, with the callbacks made before parse returns, rather than
+holding all text until eof.  The memory used and the time to the first
+callback then follow the size of each parse rather than the whole input.
+Text is held only until the end of a line that doesn't continue a comment,
+string, attribute or protected region.  The callbacks are the same as
+without incremental.
+
 Adding "symbol_table => []" will use the specified symbol table for this
-parse, and modify the array reference to include those symbols detected by
-this parse.  As the SystemVerilog language requires packages and typedefs
-to exist before they are referenced, you must pass the same symbol_table to
-subsequent parses that are for the same compilation scope.  The internals
+parse, and the symbols detected by this parse will be available through
+the symbol_table method.  As the SystemVerilog language requires packages
+and typedefs to exist before they are referenced, you must pass the same
+symbol_table to subsequent parses that are for the same compilation scope;
+parsers given the same array share one set of symbols.  The internals
 of this symbol_table should be considered opaque, as it will change between
 package versions, and must not be modified by user code.
 
@@ -367,7 +440,8 @@ Return (if $set is undefined) or set current line number.
 =item $parser->parse($string)
 
 Parse the $string as verilog text.  Can be called multiple times.  Note not
-all callbacks may be invoked until the eof method is called.
+all callbacks may be invoked until the eof method is called, and unless the
+incremental option was passed to new, none are.
 
 =item $parser->parse_file($filename);
 
@@ -375,10 +449,40 @@ This method can be called to parse text from a file.  The argument can
 be a filename or an already opened file handle. The return value from
 parse_file() is a reference to the parser object.
 
+=item $parser->parse_files([$filename,...], threads=>$n, ...);
+
+This method can be called to preprocess and parse each of the given files
+in order, sharing one set of defines, as if each were opened with a new
+Verilog::Preproc and passed to parse_preproc_file.  Other arguments are
+passed to the preprocessor's new method; "preproc" names its class.  With
+threads greater than one, up to that many files are preprocessed ahead on
+other threads while earlier files are parsed.  A file read ahead whose
+preprocessing depended on a define that an earlier file changed is
+preprocessed again, so the results match those from one thread.
+
 =item $parser->parse_preproc_file($preproc);
 
 This method can be called to parse preprocessed text from a predeclared
-Verilog::Preproc object.
+Verilog::Preproc object.  Unless the getall, parse or eof methods are
+overridden, the text is passed from the preprocessor to the parser without
+going through Perl, and parsed as it is preprocessed rather than after the
+whole file has been read.
+
+=item $parser->stats()
+
+Returns a reference to a hash of statistics about this parser.  "bytes" is
+the number of bytes of text parsed, and "copied_bytes" the number of bytes
+copied between the caller, or preprocessor, and the lexer.  Text passed to
+parse is normally lexed from the caller's string, and copied only into the
+lexer's buffer, so "copied_bytes" is about equal to "bytes".  Sharing the
+caller's string needs Perl 5.20 or later; earlier Perls copy it once more.
+
+=item $parser->symbol_table()
+
+Returns the symbol_table array reference, filled in with the symbols
+detected so far.  The parser keeps its symbols internally, and only copies
+them into the array when this method is called, so arrays held from an
+earlier call do not see later symbols.
 
 =item $parser->unreadback($string)
 
@@ -28,12 +28,15 @@
 
 /* Mine: */
 #include "VParse.h"
+#include "VPreTextSource.h"
 #include "VSymTable.h"
 #include "VAst.h"
 #include <cstring>
 #include <deque>
+#include <map>
 
 /* Perl */
+#define NO_XSLOCKS	/* For dXCPT */
 extern "C" {
 # include "EXTERN.h"
 # include "perl.h"
@@ -225,11 +228,39 @@ public:
     void pushFl() { m_vParserp->m_filelineps.push_back(this); }
 };
 
+#//**********************************************************************
+#// Text from a Perl string, lexed without copying where Perl allows
+
+// SV_COW_OTHER_PVS isn't public API, but is what Perl's own copies pass to
+// share a buffer; copy-on-write is only on by default from Perl 5.20.
+// Older Perls, or ones without the flag, just copy the text once more.
+#if defined(SV_COW_OTHER_PVS) && (PERL_REVISION > 5 || (PERL_REVISION == 5 && PERL_VERSION >= 20))
+# define VPARSE_SV_COW (SV_COW_SHARED_HASH_KEYS|SV_COW_OTHER_PVS)
+#else
+# define VPARSE_SV_COW 0
+#endif
+
+class VParseTextXs : public VParseText {
+    SV*		m_svp;	// Our copy of the string, normally sharing the caller's buffer
+public:
+    VParseTextXs(SV* textsvp) : VParseText(NULL, 0) {
+	// A copy-on-write copy, so the caller may then change their string.
+	// Perl only shares the buffer with XS copies when asked to.
+	m_svp = newSV(0);
+	sv_setsv_flags(m_svp, textsvp, SV_GMAGIC|SV_NOSTEAL|VPARSE_SV_COW);
+	STRLEN len;
+	m_textp = SvPV(m_svp, len);
+	m_len = len;
+	if (!SvPOK(textsvp) || SvPVX(textsvp) != m_textp) m_copyBytes = len;
+    }
+    virtual ~VParseTextXs() { SvREFCNT_dec(m_svp); }
+};
+
 #//**********************************************************************
 #// Overrides error handling virtual functions to invoke callbacks
 
 void VFileLineParseXs::error(const string& msg) {
-    static string holdmsg; holdmsg = msg;
+    string holdmsg = msg;
     m_vParserp->cbFileline(this);
     // Call always, not just if callbacks enabled
     m_vParserp->call(NULL, 1,"error",holdmsg.c_str());
@@ -395,6 +426,36 @@ CODE:
     THIS->callbackMasterEna(flag);
 }
 
+#//**********************************************************************
+#// self->_incremental(flag)
+
+void
+VParserXs::_incremental(flag)
+bool flag
+PROTOTYPE: $$
+CODE:
+{
+    THIS->incremental(flag);
+}
+
+#//**********************************************************************
+#// self->stats()
+
+SV*
+VParserXs::stats()
+PROTOTYPE: $
+CODE:
+{
+    map<string,size_t> stats;
+    THIS->stats(stats/*ref*/);
+    HV* hvp = newHV();
+    for (map<string,size_t>::const_iterator it=stats.begin(); it!=stats.end(); ++it) {
+	hv_store(hvp, it->first.c_str(), it->first.length(), newSVuv(it->second), 0);
+    }
+    RETVAL = newRV_noinc((SV*)hvp);
+}
+OUTPUT: RETVAL
+
 #//**********************************************************************
 #// self->_use_cb(name,flag)
 #// Turn off specified callback
@@ -470,13 +531,56 @@ OUTPUT: RETVAL
 #// self->parse()
 
 void
-VParserXs::parse(const char* textp)
+VParserXs::parse(SV* textsvp)
+PROTOTYPE: $$
+CODE:
+{
+    THIS->parse(new VParseTextXs(textsvp));
+}
+
+#//**********************************************************************
+#// self->_parse_preproc(text_source)
+
+void
+VParserXs::_parse_preproc(IV source)
+PROTOTYPE: $$
+CODE:
+{
+    // A callback may croak out of parsing, which skips C++ destructors,
+    // so the source (soon freed by Perl) must be forgotten here
+    dXCPT;
+    XCPT_TRY_START {
+	THIS->parseSource(INT2PTR(VPreTextSource*, source));
+    } XCPT_TRY_END
+    XCPT_CATCH {
+	THIS->parseSourceDone();
+	XCPT_RETHROW;
+    }
+}
+
+#//**********************************************************************
+#// self->_symbol_table_export(avp)
+
+void
+VParserXs::_symbol_table_export(AV* avp)
 PROTOTYPE: $$
 CODE:
 {
-    THIS->parse(textp);
+    THIS->syms().tablep()->exportAV(avp);
 }
 
+#//**********************************************************************
+#// self->_symbol_table_exists(name)
+
+bool
+VParserXs::_symbol_table_exists(const char* namep)
+PROTOTYPE: $$
+CODE:
+{
+    RETVAL = (THIS->syms().netlistSymp()->findSym(namep) != NULL);
+}
+OUTPUT: RETVAL
+
 #//**********************************************************************
 #// self->selftest()
 
@@ -25,7 +25,9 @@
 #include "VSymTable.h"
 #include "VAst.h"
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <map>
 
 /* Perl */
 extern "C" {
@@ -35,130 +37,94 @@ extern "C" {
 }
 
 //######################################################################
-// VAstEnt
-//
-// A symtable is simply a hash(HV) by name of the object
-// Under each hash entry (HE) is an array (AV)
-// Under each array (AV) is an [SV with type, SV with HV of lower symtab]
-
-#if 0
-# define DBG_SV_DUMP(SVp) {printf("%s:%d:\n",__FILE__,__LINE__); Perl_sv_dump(aTHX_ (SV*)(SVp)); }
-# define DBG_UINFO(z,msg) {printf("%s:%d: ", __FILE__,__LINE__); cout << msg; }
-#else
-# define DBG_SV_DUMP(SVp)
-# define DBG_UINFO(z,msg)
-#endif
-
-int VAstEnt::s_debug = 0;
+// VAstNames
 
-// ACCESSORS
-VAstType VAstEnt::type() {
-    assert(this);
-    AV* avp = castAVp();
-    if (!avp || SvTYPE(avp) != SVt_PVAV || av_len(avp)<1) return VAstType::AN_ERROR;
-    // $type_svpp = $this->[0]
-    SV** type_svpp = av_fetch(avp, 0, 0);
-    if (!type_svpp) return VAstType::AN_ERROR;
-    VAstType type = (VAstType)(SvIV(*type_svpp));
-    return type;
+size_t VAstNames::hash(const char* textp, size_t len) {
+    // FNV-1a
+    size_t hash = 2166136261U;
+    for (const char* cp = textp; cp < textp+len; ++cp) {
+	hash = (hash ^ (unsigned char)(*cp)) * 16777619U;
+    }
+    return hash;
 }
 
-HV* VAstEnt::subhash() {
-    assert(this);
-    AV* avp = castAVp();
-    if (!avp || SvTYPE(avp) != SVt_PVAV) return NULL; /*Error*/
-    // $type_svpp = $this->[2]
-    SV** hash_svpp = av_fetch(avp, 2, 0);
-    if (!hash_svpp || !SvROK(*hash_svpp) || SvTYPE(SvRV(*hash_svpp)) != SVt_PVHV) return NULL; /*Error*/
-    // $hash_hvp = %{$this->[2]}
-    HV* hash_hvp = (HV*)(SvRV(*hash_svpp));
-    return hash_hvp;
+int VAstNames::find(const char* textp, size_t len) const {
+    size_t mask = m_slots.size()-1;
+    for (size_t i = hash(textp,len) & mask; m_slots[i]; i = (i+1) & mask) {
+	const string& name = m_names[m_slots[i]-1];
+	if (name.length() == len && 0==memcmp(name.data(), textp, len)) return m_slots[i]-1;
+    }
+    return -1;
 }
 
-VAstEnt* VAstEnt::parentp() {
-    assert(this);
-    AV* avp = castAVp();
-    if (!avp || SvTYPE(avp) != SVt_PVAV) return NULL; /*Error*/
-    // $parent_svpp = $this->[1]
-    SV** parent_svpp = av_fetch(avp, 1, 0);
-    if (!parent_svpp || !SvROK(*parent_svpp) || SvTYPE(SvRV(*parent_svpp)) != SVt_PVAV) return NULL; /*Error*/
-    // $parent_svp = @{$this->[1]}
-    AV* parent_avp = (AV*)(SvRV(*parent_svpp));
-    return avToSymEnt(parent_avp);
+unsigned VAstNames::intern(const string& name) {
+    int found = find(name);
+    if (found >= 0) return found;
+    if ((m_names.size()+1)*2 > m_slots.size()) grow();
+    unsigned id = m_names.size();
+    m_names.push_back(name);
+    size_t mask = m_slots.size()-1;
+    size_t i = hash(name.data(),name.length()) & mask;
+    while (m_slots[i]) i = (i+1) & mask;
+    m_slots[i] = id+1;
+    return id;
 }
 
-// METHODS
-void VAstEnt::initNetlist(VFileLine* fl) {
-    // Called on initial creation to check if this is a netlist, and/or create it
-    assert(this);
-    AV* avp = castAVp();
-    if (!avp || SvTYPE(avp) != SVt_PVAV) { fl->error("Parser->symbol_table isn't an array reference"); }
-    if (type() == VAstType::AN_ERROR) { // Need init
-	initAVEnt(avp, VAstType::NETLIST, NULL);
-    } else if (type() == VAstType::NETLIST) { // Already inited
-    } else { fl->error("Parser->symbol_table isn't a netlist object (not created by the parser?)"); }
+void VAstNames::grow() {
+    m_slots.assign(m_slots.size()*2, 0);
+    size_t mask = m_slots.size()-1;
+    for (unsigned id=0; id<m_names.size(); ++id) {
+	size_t i = hash(m_names[id].data(),m_names[id].length()) & mask;
+	while (m_slots[i]) i = (i+1) & mask;
+	m_slots[i] = id+1;
+    }
 }
 
-AV* VAstEnt::newAVEnt(VAstType type) {
-    AV* avp = newAV();
-    initAVEnt(avp, type, this->castAVp());
-    return avp;
-}
+//######################################################################
+// VAstEnt
 
-void VAstEnt::initAVEnt(AV* avp, VAstType type, AV* parentp) {
-    // $avp = [type, parent, {}]
-    av_push(avp, newSViv(type));
-    if (parentp) {
-	SV* parentsv = newRV((SV*)parentp);
-#ifdef SvWEAKREF // Newer perls
-	// We're making a circular reference, so to garbage collect properly we need to break it
-	// On older Perl's we'll just leak.
-	sv_rvweaken(parentsv);
-#endif
-	av_push(avp, parentsv );
-    } else { // netlist top
-	av_push(avp, &PL_sv_undef);
+int VAstEnt::s_debug = 0;
+
+void VAstEnt::grow() {
+    vector<Slot> old;
+    old.swap(m_slots);
+    Slot empty = {0, NULL};
+    m_slots.assign(old.empty() ? 8 : old.size()*2, empty);
+    size_t mask = m_slots.size()-1;
+    for (vector<Slot>::iterator it=old.begin(); it!=old.end(); ++it) {
+	if (!it->m_entp) continue;
+	size_t i = it->m_nameId & mask;
+	while (m_slots[i].m_entp) i = (i+1) & mask;
+	m_slots[i] = *it;
     }
-    av_push(avp, newRV_noinc((SV*)newHV()) );
 }
 
-void VAstEnt::replaceInsert(VAstEnt* newentp, const string& name) {
-    if (debug()) cout<<"VAstEnt::replaceInsert under="<<this<<" "<<newentp->ascii(name)<<"\"\n";
-    HV* hvp = subhash(); assert(hvp);
-
-    // $svpp = $table{$name}
-    SV** svpp = hv_fetch(hvp, name.c_str(), name.length(), 1/*create*/);
-    if (svpp) {} // unused
-
-    // $avp = $newentp (premade avp)
-    hv_store(hvp, name.c_str(), name.length(), newRV((SV*)newentp), 0);
+void VAstEnt::replaceInsert(VAstEnt* newentp, unsigned nameId) {
+    if (debug()) cout<<"VAstEnt::replaceInsert under="<<this<<" "<<newentp->ascii(m_tablep->names().name(nameId))<<"\"\n";
+    if ((m_count+1)*2 > m_slots.size()) grow();
+    size_t mask = m_slots.size()-1;
+    size_t i = nameId & mask;
+    for (; m_slots[i].m_entp; i = (i+1) & mask) {
+	if (m_slots[i].m_nameId == nameId) { m_slots[i].m_entp = newentp; return; }
+    }
+    m_slots[i].m_nameId = nameId;
+    m_slots[i].m_entp = newentp;
+    ++m_count;
 }
 
 VAstEnt* VAstEnt::replaceInsert(VAstType type, const string& name) {
     if (debug()) cout<<"VAstEnt::replaceInsert under="<<this<<" "<<type.ascii()<<"-\""<<name<<"\"\n";
-    HV* hvp = subhash(); assert(hvp);
-
-    // $svpp = $table{$name}
-    SV** svpp = hv_fetch(hvp, name.c_str(), name.length(), 1/*create*/);
-    if (svpp) {} // unused
-
-    // $avp = [type, this, {}]
-    AV* sub_avp = newAVEnt(type);
-    hv_store(hvp, name.c_str(), name.length(), newRV_noinc((SV*)sub_avp), 0);
-    return avToSymEnt(sub_avp);
+    // The entry replaced, if any, stays in the table, as the grammar may point to it
+    VAstEnt* entp = m_tablep->newEnt(type, this);
+    replaceInsert(entp, m_tablep->names().intern(name));
+    return entp;
 }
 
 VAstEnt* VAstEnt::findSym(const string& name) {
-    HV* hvp = subhash();  assert(hvp);
-    // $svpp = $table{$name}
-    SV** svpp = hv_fetch(hvp, name.c_str(), name.length(), 0/*no-change*/);
-    if (!svpp) return NULL;
-    SV* svp = *svpp;
-    if (!svp || !SvROK(svp) || SvTYPE(SvRV(svp)) != SVt_PVAV) return NULL;
-    // $sub_avp = @{$table{$name}}
-    AV* sub_avp = (AV*)(SvRV(svp));
-    VAstEnt* entp = avToSymEnt(sub_avp);
-    if (debug()) cout<<"VAstEnt::find found under="<<this<<" "<<entp->ascii(name)<<"\n";
+    int nameId = m_tablep->names().find(name);
+    if (nameId < 0) return NULL;
+    VAstEnt* entp = findSymId(nameId);
+    if (entp && debug()) cout<<"VAstEnt::find found under="<<this<<" "<<entp->ascii(name)<<"\n";
     return entp;
 }
 
@@ -177,20 +143,15 @@ void VAstEnt::import(VAstEnt* pkgEntp, const string& id_or_star) {
 	if (VAstEnt* idEntp = pkgEntp->findSym(id_or_star)) {
 	    // We can just add a second reference to the same AstEnt object
 	    if (debug()) cout<<"VAstEnt::import under="<<this<<" "<<idEntp->ascii()<<"\n";
-	    replaceInsert(idEntp, id_or_star);
+	    replaceInsert(idEntp, m_tablep->names().find(id_or_star));
 	}
     } else {
-	// Walk old sym table
-	HV* hvp = pkgEntp->subhash();  assert(hvp);
-	hv_iterinit(hvp);
-	while (HE* hep = hv_iternext(hvp)) {
-	    I32 retlen;
-	    const char* namep = hv_iterkey(hep, &retlen);
-	    string name = string(namep,retlen);
-	    SV* svp = hv_iterval(hvp, hep);
-	    VAstEnt* idEntp = avToSymEnt((AV*)(SvRV(svp)));
-	    if (debug()) cout<<"VAstEnt::import under="<<this<<" "<<idEntp->ascii(name)<<"\n";
-	    replaceInsert(idEntp, name);
+	// Walk old sym table; copied as it may be this table
+	vector<Slot> slots = pkgEntp->m_slots;
+	for (vector<Slot>::iterator it=slots.begin(); it!=slots.end(); ++it) {
+	    if (!it->m_entp) continue;
+	    if (debug()) cout<<"VAstEnt::import under="<<this<<" "<<it->m_entp->ascii(m_tablep->names().name(it->m_nameId))<<"\n";
+	    replaceInsert(it->m_entp, it->m_nameId);
 	}
     }
 }
@@ -201,5 +162,184 @@ string VAstEnt::ascii(const string& name) {
     return out;
 }
 
+//######################################################################
+// VAstTable
+
+VAstTable* VAstTable::clone() const {
+    VAstTable* newp = new VAstTable;
+    newp->m_names = m_names;
+    map<const VAstEnt*,VAstEnt*> remap;
+    remap[&m_ents.front()] = newp->netlistp();
+    for (deque<VAstEnt>::const_iterator it=m_ents.begin()+1; it!=m_ents.end(); ++it) {
+	remap[&*it] = newp->newEnt(it->type(), NULL);
+    }
+    for (deque<VAstEnt>::const_iterator it=m_ents.begin(); it!=m_ents.end(); ++it) {
+	VAstEnt* entp = remap[&*it];
+	entp->m_parentp = it->m_parentp ? remap[it->m_parentp] : NULL;
+	entp->m_slots = it->m_slots;
+	entp->m_count = it->m_count;
+	for (vector<VAstEnt::Slot>::iterator sit=entp->m_slots.begin(); sit!=entp->m_slots.end(); ++sit) {
+	    if (sit->m_entp) sit->m_entp = remap[sit->m_entp];
+	}
+    }
+    return newp;
+}
+
+//######################################################################
+// VAstTable, Perl interface
+//
+// A symtable is seen by Perl as an array (AV) of [type, parent, {}].
+// The hash (HV) is by name of the objects under it, each another array.
+// The native table is attached to the top array with magic, so parsers
+// given the same array share it, and it lives as long as the array.
+
+static int vastTableMgFree(pTHX_ SV* /*svp*/, MAGIC* mgp) {
+    ((VAstTable*)(mgp->mg_ptr))->unref();
+    return 0;
+}
+
+#ifdef USE_ITHREADS
+static int vastTableMgDup(pTHX_ MAGIC* mgp, CLONE_PARAMS* /*paramp*/) {
+    // Each interpreter thread gets its own copy
+    mgp->mg_ptr = (char*)(((VAstTable*)(mgp->mg_ptr))->clone());
+    return 0;
+}
+#endif
+
+static MGVTBL vastTableVtbl = {
+    NULL, NULL, NULL, NULL, vastTableMgFree, NULL,
+#ifdef USE_ITHREADS
+    vastTableMgDup,
+#else
+    NULL,
+#endif
+    NULL };
+
+static MAGIC* avTableMagic(AV* avp) {
+    // As mg_findext, which older Perls lack
+    for (MAGIC* mgp = SvMAGIC((SV*)avp); mgp; mgp = mgp->mg_moremagic) {
+	if (mgp->mg_type == PERL_MAGIC_ext && mgp->mg_virtual == &vastTableVtbl) return mgp;
+    }
+    return NULL;
+}
+
+static HV* avSubhash(AV* avp) {
+    // $hash_hvp = %{$avp->[2]}
+    SV** hash_svpp = av_fetch(avp, 2, 0);
+    if (!hash_svpp || !SvROK(*hash_svpp) || SvTYPE(SvRV(*hash_svpp)) != SVt_PVHV) return NULL; /*Error*/
+    return (HV*)(SvRV(*hash_svpp));
+}
+
+static AV* avParent(AV* avp) {
+    // $parent_avp = @{$avp->[1]}
+    SV** parent_svpp = av_fetch(avp, 1, 0);
+    if (!parent_svpp || !SvROK(*parent_svpp) || SvTYPE(SvRV(*parent_svpp)) != SVt_PVAV) return NULL;
+    return (AV*)(SvRV(*parent_svpp));
+}
+
+static VAstType avType(AV* avp) {
+    // $type = $avp->[0]
+    if (!avp || SvTYPE(avp) != SVt_PVAV || av_len(avp)<1) return VAstType::AN_ERROR;
+    SV** type_svpp = av_fetch(avp, 0, 0);
+    if (!type_svpp) return VAstType::AN_ERROR;
+    return VAstType((int)(SvIV(*type_svpp)));
+}
+
+VAstTable* VAstTable::fromAV(VFileLine* fl, AV* avp) {
+    if (SvTYPE(avp) != SVt_PVAV) { fl->error("Parser->symbol_table isn't an array reference"); }
+    if (MAGIC* mgp = avTableMagic(avp)) {
+	VAstTable* tablep = (VAstTable*)(mgp->mg_ptr);
+	tablep->ref();
+	return tablep;
+    }
+    VAstTable* tablep = new VAstTable;
+    if (av_len(avp) >= 0) tablep->importAV(fl, avp);  // Filled by Perl, not a parser
+    MAGIC* mgp = sv_magicext((SV*)avp, NULL, PERL_MAGIC_ext, &vastTableVtbl, (const char*)tablep, 0);
+    mgp->mg_flags |= MGf_DUP;
+    tablep->ref();  // One for the array, one for the caller
+    return tablep;
+}
+
+void VAstTable::importAV(VFileLine* fl, AV* avp) {
+    if (avType(avp) != VAstType::NETLIST) {
+	fl->error("Parser->symbol_table isn't a netlist object (not created by the parser?)");
+	return;
+    }
+    map<AV*,VAstEnt*> done;
+    done[avp] = netlistp();
+    importAVEnt(netlistp(), avp, done);
+    // Entries imported into other scopes were made under whichever scope was seen first
+    for (map<AV*,VAstEnt*>::iterator it=done.begin(); it!=done.end(); ++it) {
+	map<AV*,VAstEnt*>::iterator pit = done.find(avParent(it->first));
+	if (it->second != netlistp() && pit != done.end()) it->second->m_parentp = pit->second;
+    }
+}
+
+void VAstTable::importAVEnt(VAstEnt* entp, AV* avp, map<AV*,VAstEnt*>& doner) {
+    HV* hvp = avSubhash(avp);
+    if (!hvp) return;
+    hv_iterinit(hvp);
+    while (HE* hep = hv_iternext(hvp)) {
+	I32 retlen;
+	const char* namep = hv_iterkey(hep, &retlen);
+	SV* svp = hv_iterval(hvp, hep);
+	if (!svp || !SvROK(svp) || SvTYPE(SvRV(svp)) != SVt_PVAV) continue;
+	AV* sub_avp = (AV*)(SvRV(svp));
+	unsigned nameId = m_names.intern(string(namep,retlen));
+	map<AV*,VAstEnt*>::iterator it = doner.find(sub_avp);
+	if (it != doner.end()) {  // Second reference, from an import
+	    entp->replaceInsert(it->second, nameId);
+	    continue;
+	}
+	VAstEnt* subp = newEnt(avType(sub_avp), entp);
+	doner[sub_avp] = subp;
+	entp->replaceInsert(subp, nameId);
+	importAVEnt(subp, sub_avp, doner);
+    }
+}
+
+void VAstTable::exportAV(AV* avp) {
+    map<const VAstEnt*,AV*> done;
+    done[netlistp()] = avp;
+    av_clear(avp);
+    exportAVFill(netlistp(), avp, done);
+    // The arrays made are now held by references from the hashes above them
+    for (map<const VAstEnt*,AV*>::iterator it=done.begin(); it!=done.end(); ++it) {
+	if (it->second != avp) SvREFCNT_dec((SV*)(it->second));
+    }
+}
+
+AV* VAstTable::exportAVEnt(const VAstEnt* entp, map<const VAstEnt*,AV*>& doner) {
+    map<const VAstEnt*,AV*>::iterator it = doner.find(entp);
+    if (it != doner.end()) return it->second;
+    AV* avp = newAV();
+    doner[entp] = avp;
+    exportAVFill(entp, avp, doner);
+    return avp;
+}
+
+void VAstTable::exportAVFill(const VAstEnt* entp, AV* avp, map<const VAstEnt*,AV*>& doner) {
+    // $avp = [type, parent, {}]
+    av_push(avp, newSViv(entp->type()));
+    if (entp->parentp()) {
+	SV* parentsv = newRV((SV*)exportAVEnt(entp->parentp(), doner));
+#ifdef SvWEAKREF // Newer perls
+	// We're making a circular reference, so to garbage collect properly we need to break it
+	// On older Perl's we'll just leak.
+	sv_rvweaken(parentsv);
+#endif
+	av_push(avp, parentsv );
+    } else { // netlist top
+	av_push(avp, &PL_sv_undef);
+    }
+    HV* hvp = newHV();
+    av_push(avp, newRV_noinc((SV*)hvp) );
+    for (vector<VAstEnt::Slot>::const_iterator it=entp->m_slots.begin(); it!=entp->m_slots.end(); ++it) {
+	if (!it->m_entp) continue;
+	const string& name = m_names.name(it->m_nameId);
+	hv_store(hvp, name.c_str(), name.length(), newRV((SV*)exportAVEnt(it->m_entp, doner)), 0);
+    }
+}
+
 #undef DBG_SV_DUMP
 #undef DBG_UINFO
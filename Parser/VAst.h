@@ -25,6 +25,9 @@
 #define _VAST_H_ 1
 
 #include <string>
+#include <deque>
+#include <map>
+#include <vector>
 #include <cstdlib>
 #include <cassert>
 using namespace std;
@@ -33,6 +36,7 @@ using namespace std;
 // code.  So just grab a minimal set.
 struct av;
 struct hv;
+class VFileLine;
 
 //######################################################################
 // Enumeration that indicates what type of symbol is in the symbol tree.
@@ -89,13 +93,44 @@ public:
   inline bool operator== (VAstType lhs, VAstType::en rhs) { return (lhs.m_e == rhs); }
   inline bool operator== (VAstType::en lhs, VAstType rhs) { return (lhs == rhs.m_e); }
 
+//######################################################################
+// Names used in a symbol table, each stored once
+
+class VAstNames {
+    vector<string>	m_names;	// Name for each id
+    vector<unsigned>	m_slots;	// Open addressed table of id+1, 0 for empty
+public:
+    VAstNames() : m_slots(64, 0) {}
+    /// Return id for given name, or -1 if never interned
+    int find(const char* textp, size_t len) const;
+    int find(const string& name) const { return find(name.data(), name.length()); }
+    /// Return id for given name, adding it if new
+    unsigned intern(const string& name);
+    const string& name(unsigned id) const { return m_names[id]; }
+private:
+    static size_t hash(const char* textp, size_t len);
+    void grow();
+};
+
 //######################################################################
 // Single symbol table
 
+class VAstTable;
+
 class VAstEnt {
 private:
+    // TYPES
+    struct Slot {
+	unsigned	m_nameId;	// Name of symbol, from the table's VAstNames
+	VAstEnt*	m_entp;		// Symbol, or NULL if slot empty
+    };
+
     // MEMBERS
-    // NOT ALLOWED - this class really has this==AV*
+    VAstType		m_type;		// Node type
+    VAstEnt*		m_parentp;	// What node it is under, or NULL if netlist
+    VAstTable*		m_tablep;	// Table owning this entry
+    vector<Slot>	m_slots;	// Open addressed symbols under this entry, by name id
+    unsigned		m_count;	// Used entries in m_slots
 
     // STATIC MEMBERS
     static int s_debug;
@@ -104,34 +139,26 @@ public:
     static int debug() { return s_debug; }
 
 private:
+    friend class VAstTable;
     // CREATORS
-    VAstEnt() { assert(0); }	// Not made by users, it's an AV*
-    ~VAstEnt() { assert(0); }	// Not made by users, it's an AV*
-
-    av* newAVEnt(VAstType type);
-    static void initAVEnt(struct av* avp, VAstType type, struct av* parentp);
-
-    // ACCESSORS
-    inline struct av* castAVp() { return (struct av*)(this); }
-    inline VAstEnt* avToSymEnt(struct av* avp) { return (VAstEnt*)(avp); }
-
-    /// $self->[2]: For current entry, the hash of symbols under it
-    struct hv* subhash();
+    VAstEnt(VAstType type, VAstEnt* parentp, VAstTable* tablep)
+	: m_type(type), m_parentp(parentp), m_tablep(tablep), m_count(0) {}
 
     /// Insert into current table
-    void replaceInsert(VAstEnt* newentp, const string& name);
+    void replaceInsert(VAstEnt* newentp, unsigned nameId);
+    void grow();
 
 public:
     // ACCESSORS
 
-    /// $self->[0]: For current entry, the node type
-    VAstType type();
+    /// For current entry, the node type
+    VAstType type() const { return m_type; }
 
-    /// $self->[1]: For current entry, what node it is under or NULL if netlist
-    VAstEnt* parentp();
+    /// For current entry, what node it is under or NULL if netlist
+    VAstEnt* parentp() const { return m_parentp; }
 
     /// type() indicates we shouldn't report this as a containing object
-    bool typeIgnoreObjof() { VAstType t=type(); return t==VAstType::BLOCK || t==VAstType::FORK; }
+    bool typeIgnoreObjof() const { VAstType t=type(); return t==VAstType::BLOCK || t==VAstType::FORK; }
 
     /// Info on current node, for debug
     string ascii(const string& name="");
@@ -139,6 +166,15 @@ public:
     // METHODS
     /// Return internal pointer for given name or null
     VAstEnt* findSym(const string& name);
+    /// Return internal pointer for given VAstNames id or null
+    VAstEnt* findSymId(unsigned nameId) {
+	if (!m_count) return NULL;
+	size_t mask = m_slots.size()-1;
+	for (size_t i = nameId & mask; m_slots[i].m_entp; i = (i+1) & mask) {
+	    if (m_slots[i].m_nameId == nameId) return m_slots[i].m_entp;
+	}
+	return NULL;
+    }
 
     /// Find or create a symbol under current entry
     VAstEnt* findInsert(VAstType type, const string& name);
@@ -148,10 +184,48 @@ public:
 
     /// Insert into current table from another imported package's table
     void import(VAstEnt* fromEntp, const string& id_or_star);
+};
+
+//######################################################################
+// Symbol tree shared by the parsers of a compilation unit
+//
+// Entries are never freed until the whole table is, so pointers to them,
+// as held by the grammar, stay valid.  Perl only sees the table as the
+// symbol_table array, which is filled in by exportAV when asked for.
 
-protected:
-    friend class VSymStack;
-    void initNetlist(VFileLine* fl);
+class VAstTable {
+    deque<VAstEnt>	m_ents;		// All entries; front is the netlist
+    VAstNames		m_names;	// Names of symbols
+    int			m_refs;		// Number of references, deleted at zero
+
+    VAstTable(const VAstTable&);	// Not copyable, see clone()
+public:
+    // CREATORS
+    VAstTable() : m_refs(1) { m_ents.push_back(VAstEnt(VAstType::NETLIST, NULL, this)); }
+    /// Return table attached to the given symbol_table array, referenced,
+    /// making it if needed from the array's existing contents
+    static VAstTable* fromAV(VFileLine* fl, struct av* avp);
+    void ref() { ++m_refs; }
+    void unref() { if (!--m_refs) delete this; }
+    /// Return new copy, with one reference
+    VAstTable* clone() const;
+
+    // ACCESSORS
+    VAstEnt* netlistp() { return &m_ents.front(); }
+    VAstNames& names() { return m_names; }
+
+    // METHODS
+    VAstEnt* newEnt(VAstType type, VAstEnt* parentp) {
+	m_ents.push_back(VAstEnt(type, parentp, this));
+	return &m_ents.back();
+    }
+    /// Replace contents of the array with the table, as [type, parent, {name=>[...]}]
+    void exportAV(struct av* avp);
+private:
+    void importAV(VFileLine* fl, struct av* avp);
+    void importAVEnt(VAstEnt* entp, struct av* avp, map<struct av*,VAstEnt*>& doner);
+    struct av* exportAVEnt(const VAstEnt* entp, map<const VAstEnt*,struct av*>& doner);
+    void exportAVFill(const VAstEnt* entp, struct av* avp, map<const VAstEnt*,struct av*>& doner);
 };
 
 #endif // guard
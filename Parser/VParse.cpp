@@ -34,8 +34,6 @@
 #include "VParseGrammar.h"
 #include "VSymTable.h"
 
-VParseGrammar*	VParseGrammar::s_grammarp = NULL;
-
 //*************************************************************************
 
 VParse::VParse(VFileLine* filelinep, av* symsp,
@@ -51,12 +49,27 @@ VParse::VParse(VFileLine* filelinep, av* symsp,
     m_lexp = new VParseLex(this);
     m_grammarp = new VParseGrammar(this);
     m_eof = false;
+    m_parseDone = false;
+    m_textSourcep = NULL;
+    m_lineMapp = NULL;
+    m_inLines = 0;
+    m_lineMarkPending = false;
+    m_lineMarkFrom = 0;
+    m_incremental = false;
+    m_pushing = false;
+    m_pushScanned = 0;
+    m_pushScan = PS_CODE;
+    m_statBytes = 0;
+    m_statCopyBytes = 0;
     m_anonNum = 0;
     m_symTableNextId = NULL;
     m_callbackMasterEna = true;
 }
 
 VParse::~VParse() {
+    for (deque<VParseSlice>::iterator it=m_buffers.begin(); it!=m_buffers.end(); ++it) {
+	it->m_textp->refDec();
+    }
     if (m_lexp) {
 	delete m_lexp;
 	m_lexp = NULL;
@@ -80,32 +93,256 @@ bool VParse::inCellDefine() const { return m_lexp->m_inCellDefine; }
 void VParse::language(const char* valuep) { m_lexp->language(valuep); }
 
 void VParse::parse(const string& text) {
-    if (debug()>=10) { cout<<"VParse::parse: '"<<text<<"'\n"; }
-    // We can't process immediately because bison has no nice way of returning
-    // to us when a complete token is recognized.
-    // YYACCEPT is one possibility, but where to call it depends on the user's callbacks.
-    // Instead, buffer until eof.
-    // But, don't buffer too large a chunk, as it we need to peel off up to 8KB chunks from it
-    const size_t max_chunk = 8191; // Flex uses 8KB chunks, so if slightly less, we won't have to move data
-    size_t pos = 0;
-    while (pos < text.length()) {
-	size_t chunk = text.length() - pos;
-	if (chunk > max_chunk) chunk = max_chunk;
-	m_buffers.push_back(string(text.data()+pos, chunk));
-	pos += chunk;
+    string textCopy (text);
+    parse(new VParseTextString(textCopy/*swapped*/, text.length()));
+}
+
+void VParse::parse(VParseText* textp) {
+    if (debug()>=10) { cout<<"VParse::parse: '"<<string(textp->data(),textp->length())<<"'\n"; }
+    m_statBytes += textp->length();
+    m_statCopyBytes += textp->copyBytes();
+    if (m_incremental) { pushText(textp); return; }
+    // Buffer until eof.  Bison returns to us at each token as a push
+    // parser, but flex can't stop in the middle of a token, so
+    // parsing as text arrives is done only when incremental.
+    bufferText(textp, 0, textp->length());
+    textp->refDec();
+}
+
+void VParse::bufferText(VParseText* textp, size_t pos, size_t end) {
+    // The text is held, not copied; inputToLex copies it into flex's buffer
+    if (pos >= end) return;
+    textp->refInc();
+    VParseSlice slice;
+    slice.m_textp = textp;
+    slice.m_pos = pos;
+    slice.m_end = end;
+    m_buffers.push_back(slice);
+}
+
+void VParse::stats(map<string,size_t>& statsr) const {
+    statsr["bytes"] = m_statBytes;
+    statsr["copied_bytes"] = m_statCopyBytes;
+}
+
+size_t VParse::pushScanText(const char* textp, size_t len) {
+    // Scan the complete lines after m_pushScanned, and return the length
+    // of text through the last line the lexer can stop after, or 0
+    size_t safe = 0;
+    while (const char* nlp = (const char*)memchr(textp+m_pushScanned, '\n', len-m_pushScanned)) {
+	bool safer;
+	m_pushScan = pushScanLine(textp+m_pushScanned, nlp, m_pushScan, safer/*ref*/);
+	m_pushScanned = nlp - textp + 1;
+	if (safer) safe = m_pushScanned;
+    }
+    return safe;
+}
+
+void VParse::pushText(VParseText* textp) {
+    // Lex and parse the lines that the lexer can stop after, keeping the
+    // rest until more text arrives.  The lexer then stops at the end of a
+    // token with no construct open, and restarts from the same state.
+    size_t safe;
+    if (m_pushText.empty()) {
+	safe = pushScanText(textp->data(), textp->length());
+    } else {
+	// Join to the unfinished text before it, usually part of one line
+	m_pushText.append(textp->data(), textp->length());
+	m_statCopyBytes += textp->length();
+	textp->refDec();
+	safe = pushScanText(m_pushText.data(), m_pushText.length());
+	if (!safe) return;
+	textp = new VParseTextString(m_pushText/*swapped*/, 0);
+    }
+    if (safe < textp->length()) {
+	m_pushText.assign(textp->data()+safe, textp->length()-safe);
+	m_statCopyBytes += textp->length()-safe;
+    }
+    m_pushScanned -= safe;
+    bufferText(textp, 0, safe);
+    textp->refDec();
+    if (!safe) return;
+
+    m_pushing = true;
+    m_lexp->restart();  // Lexer last returned EOF; or new parse
+    if (sigParser()) {
+	if (!m_parseDone && m_grammarp->parse()) m_parseDone = true;
+    } else {
+	fakeBison();
+    }
+}
+
+static inline bool pushScanWs(char c) { return c==' ' || c=='\t' || c=='\f' || c=='\r'; }
+
+static const char* pushScanWord(const char* cp, const char* endp, const char* word) {
+    // Return end of word if cp starts with it, else NULL
+    size_t len = strlen(word);
+    if ((size_t)(endp-cp) < len || 0!=strncmp(cp, word, len)) return NULL;
+    return cp+len;
+}
+
+static const char* pushScanProtect(const char* cp, const char* endp, const char* which) {
+    // Return end of "pragma{ws}+protect{ws}+which" if cp starts with it, else NULL
+    if (!(cp = pushScanWord(cp, endp, "pragma"))) return NULL;
+    if (cp == endp || !pushScanWs(*cp)) return NULL;
+    while (cp < endp && pushScanWs(*cp)) ++cp;
+    if (!(cp = pushScanWord(cp, endp, "protect"))) return NULL;
+    if (cp == endp || !pushScanWs(*cp)) return NULL;
+    while (cp < endp && pushScanWs(*cp)) ++cp;
+    return pushScanWord(cp, endp, which);
+}
+
+VParse::PushScan VParse::pushScanLine(const char* cp, const char* endp, PushScan state, bool& safer) {
+    // Follow the constructs VParseLex.l lexes across lines through the
+    // line from cp to the newline at endp, and return what is open at the
+    // end.  Set safer if the lexer may stop after the newline.  Anything
+    // unclear is treated as open, which only delays lexing.
+    //
+    // This must mirror, and be kept up to date with, the VParseLex.l
+    // states that continue over a newline:
+    //   CMTMODE   /* ... */ comments                     -> PS_COMMENT
+    //   STRING    "..." strings, with \ escapes          -> PS_STRING
+    //   ATTRMODE  "(*" then an identifier, to "*)"       -> PS_ATTR_MAYBE, PS_ATTR
+    //   PROTMODE  `protected or [//|`]pragma protect
+    //             begin_protected, to the matching end   -> PS_PROTECTED
+    // and the INITIAL rules that match to the end of the line: // comments,
+    // escaped identifiers, and `line, `pragma, `timescale,
+    // `default_decay_time and `default_trireg_strength; and numbers, whose
+    // base and digits may be split by whitespace.
+    char last = 0;  // Last code character, or 0 after a comment, string etc
+    char prev = 0;  // Character before last
+    while (cp < endp) {
+	const char* ep;
+	switch (state) {
+	case PS_COMMENT:
+	    if (cp[0]=='*' && cp+1<endp && cp[1]=='/') { state = PS_CODE; cp += 2; }
+	    else ++cp;
+	    break;
+	case PS_STRING:
+	    if (cp[0]=='\\') cp += 2;
+	    else if (*cp++ == '"') state = PS_CODE;
+	    break;
+	case PS_ATTR_MAYBE:
+	    // "(*" with only whitespace so far; an identifier starts an attribute
+	    if (pushScanWs(*cp)) { ++cp; break; }
+	    state = (isalpha(*cp) || *cp=='_' || *cp=='\\') ? PS_ATTR : PS_CODE;
+	    break;  // Same character in new state
+	case PS_ATTR:
+	    if (cp[0]=='*' && cp+1<endp && cp[1]==')') { state = PS_CODE; cp += 2; }
+	    else ++cp;
+	    break;
+	case PS_PROTECTED:
+	    if ((ep = pushScanWord(cp, endp, "`endprotected"))
+		|| (cp[0]=='`' && (ep = pushScanProtect(cp+1, endp, "end_protected")))) {
+		state = PS_CODE; cp = ep;
+	    } else if (cp[0]=='/' && cp+1<endp && cp[1]=='/') {
+		const char* sp = cp+2;
+		while (sp < endp && pushScanWs(*sp)) ++sp;
+		if ((ep = pushScanProtect(sp, endp, "end_protected"))) { state = PS_CODE; cp = ep; }
+		else ++cp;
+	    } else {
+		++cp;
+	    }
+	    break;
+	case PS_CODE:
+	    if (cp[0]=='/' && cp+1<endp && cp[1]=='/') {
+		const char* sp = cp+2;
+		while (sp < endp && pushScanWs(*sp)) ++sp;
+		if ((ep = pushScanProtect(sp, endp, "begin_protected"))) { state = PS_PROTECTED; cp = ep; }
+		else cp = endp;
+		last = prev = 0;
+	    } else if (cp[0]=='/' && cp+1<endp && cp[1]=='*') {
+		state = PS_COMMENT; cp += 2; last = prev = 0;
+	    } else if (cp[0]=='"') {
+		state = PS_STRING; ++cp; last = prev = 0;
+	    } else if (cp[0]=='\\') {  // Escaped identifier
+		while (cp < endp && !pushScanWs(*cp)) ++cp;
+		last = prev = 0;
+	    } else if (cp[0]=='(' && cp+1<endp && cp[1]=='*') {
+		state = PS_ATTR_MAYBE; cp += 2;
+	    } else if (cp[0]=='`') {
+		if (((ep = pushScanWord(cp, endp, "`protected")) && (ep==endp || !(isalnum(*ep) || *ep=='_')))
+		    || (ep = pushScanProtect(cp+1, endp, "begin_protected"))) {
+		    state = PS_PROTECTED; cp = ep;
+		} else if (((ep = pushScanWord(cp, endp, "`line"))
+			    || (ep = pushScanWord(cp, endp, "`pragma"))
+			    || (ep = pushScanWord(cp, endp, "`timescale"))
+			    || (ep = pushScanWord(cp, endp, "`default_decay_time"))
+			    || (ep = pushScanWord(cp, endp, "`default_trireg_strength")))
+			   && ep < endp && pushScanWs(*ep)) {
+		    // Directive takes the rest of the line
+		    while (ep < endp && *ep != '\r') ++ep;
+		    cp = ep; last = prev = 0;
+		} else {
+		    prev = last; last = *cp++;
+		}
+	    } else {
+		if (!pushScanWs(*cp)) { prev = last; last = *cp; }
+		++cp;
+	    }
+	    break;
+	}
+    }
+    // Numbers may continue on the next line after digits, ' or a base
+    safer = (state == PS_CODE
+	     && !isdigit(last) && last != '\''
+	     && !(last && strchr("bcodhBCODHsS", last) && (prev=='\'' || prev=='s' || prev=='S')));
+    return state;
+}
+
+void VParse::parseSource(VPreTextSource* sourcep) {
+    // Rather than buffering all text until eof, the lexer pulls
+    // from the preprocessor as it needs more characters
+    m_textSourcep = sourcep;
+    if (m_buffers.empty()) {
+	// Lines are counted from the start of the source's text, and
+	// locations the source gives in place of `line applied as reached
+	m_lineMapp = sourcep;
+	m_inLines = 0;
+	m_lineMarkPending = false;
+	m_lineMarkFrom = 0;
+    }
+    setEof();
+    parseSourceDone();
+}
+
+void VParse::parseSourceDone() {
+    m_textSourcep = NULL;
+    m_lineMapp = NULL;
+}
+
+void VParse::lineMarkApply() {
+    // Move to the location of each mark at or before the current line.
+    // A mark is always known before the text of its line is read.
+    while (m_lineMarkPending || m_lineMapp->nextLineMark(m_lineMarkFrom, m_lineMark/*ref*/)) {
+	m_lineMarkPending = true;
+	if (m_lineMark.m_outLine > m_inLines) return;
+	m_inFilelinep = m_inFilelinep->create(m_lineMark.m_filename, m_lineMark.m_lineno);
+	m_lineMarkFrom = m_lineMark.m_outLine + 1;
+	m_lineMarkPending = false;
     }
 }
 
 void VParse::setEof() {
     m_eof = true;
     if (debug()) { cout<<"VParse::setEof: for "<<(void*)(this)<<endl; }
+    if (m_pushing) {
+	// Incremental parse continues with the rest of the text
+	VParseText* textp = new VParseTextString(m_pushText/*swapped*/, 0);
+	bufferText(textp, 0, textp->length());
+	textp->refDec();
+	m_pushScanned = 0;
+	m_pushScan = PS_CODE;
+	m_pushing = false;
+    }
     m_lexp->restart();
     if (sigParser()) {
 	// Use the bison parser
-	m_grammarp->parse();
+	if (!m_parseDone) m_grammarp->parse();
     } else {
 	fakeBison();
     }
+    m_parseDone = false;
     // End of parsing callback
     endparseCb(inFilelinep(),"");
     if (debug()) { cout<<"VParse::setEof: DONE\n"; }
@@ -127,16 +364,27 @@ size_t VParse::inputToLex(char* buf, size_t max_size) {
     size_t got = 0;
     while (got < max_size	// Haven't got enough
 	   && !m_buffers.empty()) {	// And something buffered
-	string front = m_buffers.front(); m_buffers.pop_front();
-	size_t len = front.length();
-	if (len > (max_size-got)) {  // Front string too big
-	    string remainder = front.substr(max_size-got);
-	    front = front.substr(0, max_size-got);
-	    m_buffers.push_front(remainder);  // Put back remainder for next time
-	    len = (max_size-got);
+	// The only copy of parse()'s text, straight from the caller's buffer
+	VParseSlice& front = m_buffers.front();
+	size_t len = front.m_end - front.m_pos;
+	if (len > (max_size-got)) len = max_size-got;  // Rest is lexed next time
+	memcpy(buf+got, front.m_textp->data()+front.m_pos, len);
+	m_statCopyBytes += len;
+	got += len;
+	front.m_pos += len;
+	if (front.m_pos == front.m_end) {
+	    front.m_textp->refDec();
+	    m_buffers.pop_front();
 	}
-	strncpy(buf+got, front.c_str(), len);
+    }
+    if (got < max_size && m_buffers.empty() && m_textSourcep) {
+	// Preprocessor copies straight into flex's buffer
+	size_t len = m_textSourcep->readText(buf+got, max_size-got);
+	if (!len) m_textSourcep = NULL;  // Exhausted
+	m_statBytes += len;
+	m_statCopyBytes += len;
 	got += len;
+	if (m_lineMapp && !m_lineMarkPending) lineMarkApply();
     }
     if (debug()>=9) {
 	string out = string(buf,got);
@@ -30,6 +30,7 @@
 #include <iostream>
 using namespace std;
 #include "VFileLine.h"
+#include "VPreTextSource.h"
 #include "VSymTable.h"
 
 class VParseLex;  // Be sure not to include it, or the Bison class will get upset
@@ -47,6 +48,50 @@ struct VParseHashElem {
     ~VParseHashElem() {}
 };
 
+//**********************************************************************
+// VParseText
+/// Text given to VParse::parse, lexed in place rather than copied.
+/// Reference counted, as incremental parsing may lex part of a text and
+/// keep the rest for later; deleted once all of it has been lexed.
+
+class VParseText {
+    int		m_refs;		///< References, one per holder
+protected:
+    const char*	m_textp;	///< Characters to parse
+    size_t	m_len;		///< Length of m_textp
+    size_t	m_copyBytes;	///< Bytes copied to make this text, for statistics
+public:
+    /// Borrow the given characters, which must not change until lexed
+    VParseText(const char* textp, size_t len)
+	: m_refs(1), m_textp(textp), m_len(len), m_copyBytes(0) {}
+    virtual ~VParseText() {}
+    const char* data() const { return m_textp; }
+    size_t length() const { return m_len; }
+    size_t copyBytes() const { return m_copyBytes; }
+    void refInc() { ++m_refs; }
+    void refDec() { if (!--m_refs) delete this; }
+};
+
+/// Text owned by the parser, taken from a string without copying
+class VParseTextString : public VParseText {
+    string	m_text;		///< Characters to parse
+public:
+    /// Takes the characters of textr, leaving it empty
+    VParseTextString(string& textr, size_t copyBytes)
+	: VParseText(NULL, 0) {
+	m_text.swap(textr);
+	m_textp = m_text.data(); m_len = m_text.length(); m_copyBytes = copyBytes;
+    }
+    virtual ~VParseTextString() {}
+};
+
+/// Part of a VParseText not yet lexed
+struct VParseSlice {
+    VParseText*	m_textp;	///< Text, holding a reference
+    size_t	m_pos;		///< Next character to lex
+    size_t	m_end;		///< End of characters to lex
+};
+
 //**********************************************************************
 // VParse
 
@@ -62,13 +107,31 @@ private:
     VParseLex*	m_lexp;		///< Current lexer state (NULL = closed)
     VParseGrammar* m_grammarp;	///< Current bison state (NULL = closed)
     bool	m_eof;		///< At end of file
+    bool	m_parseDone;	///< Grammar finished before the end of input
     bool	m_callbackMasterEna; ///< Callbacks are enabled
 
     bool	m_useUnreadback;///< Need m_unreadback tracking
     bool	m_useProtected;	///< Need `protected tracking
     bool	m_usePinselects;///< Need bit-select parsing
     string	m_unreadback;	///< Otherwise unprocessed whitespace before current token
-    deque<string> m_buffers;	///< Buffer of characters to process
+    deque<VParseSlice> m_buffers;	///< Text to process, lexed in place
+    VPreTextSource* m_textSourcep;	///< Characters to process after m_buffers, or NULL
+    VPreTextSource* m_lineMapp;	///< Source giving locations by nextLineMark, or NULL
+    size_t	m_inLines;	///< Newlines lexed from m_lineMapp's text
+    VPreLineMark m_lineMark;	///< Next location change from m_lineMapp
+    bool	m_lineMarkPending;	///< m_lineMark is valid and not yet reached
+    size_t	m_lineMarkFrom;	///< Output line to look for the next mark from
+
+    // For incremental parsing
+    enum PushScan { PS_CODE, PS_COMMENT, PS_STRING, PS_ATTR_MAYBE, PS_ATTR, PS_PROTECTED };
+    bool	m_incremental;	///< Lex and parse text as each parse() arrives
+    bool	m_pushing;	///< Incremental parse started and setEof not yet called
+    string	m_pushText;	///< Incremental text not yet safe to lex
+    size_t	m_pushScanned;	///< Characters of m_pushText already scanned
+    PushScan	m_pushScan;	///< Construct open at m_pushScanned
+
+    size_t	m_statBytes;	///< Bytes of text parsed
+    size_t	m_statCopyBytes;	///< Bytes copied between the caller and the lexer
 
     int		m_anonNum;	///< Number of next anonymous object
 
@@ -79,7 +142,9 @@ private:
 public:  // But for internalish use only
     // METHODS
     int lexToBison(VParseBisonYYSType* yylvalp);
-    bool eofToLex() const { return m_eof && m_buffers.empty(); }
+    bool eofToLex() const { return (m_eof || m_pushing) && m_buffers.empty() && !m_textSourcep; }
+    /// When the lexer returns EOF, it's only out of incremental input so far
+    bool lexSuspended() const { return m_pushing; }
     bool inCellDefine() const;
     size_t inputToLex(char* buf, size_t max_size);
 
@@ -119,6 +184,11 @@ public:  // But for internalish use only
 
 private:
     void fakeBison();
+    void lineMarkApply();
+    void bufferText(VParseText* textp, size_t pos, size_t end);
+    void pushText(VParseText* textp);
+    size_t pushScanText(const char* textp, size_t len);
+    static PushScan pushScanLine(const char* cp, const char* endp, PushScan state, bool& safer);
 
 public:
     // CONSTRUCTORS
@@ -130,9 +200,16 @@ public:
     /// Insert given file into this point in input stream
     int debug() const { return m_debug; }	///< Set debugging level
     void debug(int level);			///< Set debugging level
-    void parse(const string& text);		///< Add given text to
+    void parse(const string& text);		///< Add copy of given text to parse
+    void parse(VParseText* textp);		///< Add given text to parse, taking the reference
     void setEof();				///< Got a end of file
+    void parseSource(VPreTextSource* sourcep);	///< Parse all text from preprocessor, then setEof
+    void parseSourceDone();			///< Forget parseSource's source, also if it croaked
     bool sigParser() const { return m_sigParser; }
+    /// Lex and parse each parse() text as it arrives, rather than at setEof
+    void incremental(bool flag) { m_incremental = flag; }
+    bool incremental() const { return m_incremental; }
+    void stats(map<string,size_t>& statsr) const;	///< Statistics counters by name
     void language(const char* valuep);
     void callbackMasterEna(bool flag) { m_callbackMasterEna=flag; }
     bool callbackMasterEna() const { return m_callbackMasterEna; }
@@ -141,7 +218,13 @@ public:
 
     VFileLine* inFilelinep() const;		///< File/Line number for last callback
     void inFileline(const string& filename, int lineno) { m_inFilelinep = m_inFilelinep->create(filename, lineno); }
-    void inFilelineInc() { m_inFilelinep = inFilelinep()->create(inFilelinep()->lineno()+1); }
+    void inFilelineInc() {
+	m_inFilelinep = inFilelinep()->create(inFilelinep()->lineno()+1);
+	if (m_lineMapp) {
+	    ++m_inLines;
+	    if (m_lineMarkPending && m_lineMark.m_outLine <= m_inLines) lineMarkApply();
+	}
+    }
     void inLineDirective(const char* text) { int ign; m_inFilelinep = inFilelinep()->lineDirective(text, ign/*ref*/); }
 
     string unreadback() const { return (m_useUnreadback ? m_unreadback : "new(...,use_unreadback=>0) was used"); }
@@ -206,48 +289,50 @@ public:
 
     // CALLBACKGEN_KEYWORDS
     // CALLBACKGEN_GENERATED_BEGIN - GENERATED AUTOMATICALLY by callbackgen
+    static set<string> keywordSet() {
+	set<string> kwdset;
+	const char* kwds[] = {
+	    "accept_on","alias","always","always_comb","always_ff","always_latch","and",
+	    "assert","assign","assume","automatic","before","begin","bind",
+	    "bins","binsof","bit","break","buf","bufif0","bufif1",
+	    "byte","case","casex","casez","cell","chandle","checker",
+	    "class","clocking","cmos","config","const","constraint","context",
+	    "continue","cover","covergroup","coverpoint","cross","deassign","default",
+	    "defparam","design","disable","dist","do","edge","else",
+	    "end","endcase","endchecker","endclass","endclocking","endconfig","endfunction",
+	    "endgenerate","endgroup","endinterface","endmodule","endpackage","endprimitive","endprogram",
+	    "endproperty","endsequence","endspecify","endtable","endtask","enum","event",
+	    "eventually","expect","export","extends","extern","final","first_match",
+	    "for","force","foreach","forever","fork","forkjoin","function",
+	    "generate","genvar","global","highz0","highz1","if","iff",
+	    "ifnone","ignore_bins","illegal_bins","implements","implies","import","incdir",
+	    "include","initial","inout","input","inside","instance","int",
+	    "integer","interconnect","interface","intersect","join","join_any","join_none",
+	    "large","let","liblist","library","local","localparam","logic",
+	    "longint","macromodule","matches","medium","modport","module","nand",
+	    "negedge","nettype","new","nexttime","nmos","nor","noshowcancelled",
+	    "not","notif0","notif1","null","or","output","package",
+	    "packed","parameter","pmos","posedge","primitive","priority","program",
+	    "property","protected","pull0","pull1","pulldown","pullup","pulsestyle_ondetect",
+	    "pulsestyle_onevent","pure","rand","randc","randcase","randsequence","rcmos",
+	    "real","realtime","ref","reg","reject_on","release","repeat",
+	    "restrict","return","rnmos","rpmos","rtran","rtranif0","rtranif1",
+	    "s_always","s_eventually","s_nexttime","s_until","s_until_with","scalared","sequence",
+	    "shortint","shortreal","showcancelled","signed","small","soft","solve",
+	    "specify","specparam","static","strength","string","strong","strong0",
+	    "strong1","struct","super","supply0","supply1","sync_accept_on","sync_reject_on",
+	    "table","tagged","task","this","throughout","time","timeprecision",
+	    "timeunit","tran","tranif0","tranif1","tri","tri0","tri1",
+	    "triand","trior","trireg","type","typedef","union","unique",
+	    "unique0","unsigned","until","until_with","untyped","use","uwire",
+	    "var","vectored","virtual","void","wait","wait_order","wand",
+	    "weak","weak0","weak1","while","wildcard","wire","with",
+	    "within","wor","xnor","xor",""};
+	for (const char** k=kwds; **k; k++) kwdset.insert(*k);
+	return kwdset;
+    }
     static bool isKeyword(const char* kwd, int leng) {
-	static set<string> s_map;
-	if (s_map.empty()) {
-	    const char* kwds[] = {
-		"accept_on","alias","always","always_comb","always_ff","always_latch","and",
-		"assert","assign","assume","automatic","before","begin","bind",
-		"bins","binsof","bit","break","buf","bufif0","bufif1",
-		"byte","case","casex","casez","cell","chandle","checker",
-		"class","clocking","cmos","config","const","constraint","context",
-		"continue","cover","covergroup","coverpoint","cross","deassign","default",
-		"defparam","design","disable","dist","do","edge","else",
-		"end","endcase","endchecker","endclass","endclocking","endconfig","endfunction",
-		"endgenerate","endgroup","endinterface","endmodule","endpackage","endprimitive","endprogram",
-		"endproperty","endsequence","endspecify","endtable","endtask","enum","event",
-		"eventually","expect","export","extends","extern","final","first_match",
-		"for","force","foreach","forever","fork","forkjoin","function",
-		"generate","genvar","global","highz0","highz1","if","iff",
-		"ifnone","ignore_bins","illegal_bins","implements","implies","import","incdir",
-		"include","initial","inout","input","inside","instance","int",
-		"integer","interconnect","interface","intersect","join","join_any","join_none",
-		"large","let","liblist","library","local","localparam","logic",
-		"longint","macromodule","matches","medium","modport","module","nand",
-		"negedge","nettype","new","nexttime","nmos","nor","noshowcancelled",
-		"not","notif0","notif1","null","or","output","package",
-		"packed","parameter","pmos","posedge","primitive","priority","program",
-		"property","protected","pull0","pull1","pulldown","pullup","pulsestyle_ondetect",
-		"pulsestyle_onevent","pure","rand","randc","randcase","randsequence","rcmos",
-		"real","realtime","ref","reg","reject_on","release","repeat",
-		"restrict","return","rnmos","rpmos","rtran","rtranif0","rtranif1",
-		"s_always","s_eventually","s_nexttime","s_until","s_until_with","scalared","sequence",
-		"shortint","shortreal","showcancelled","signed","small","soft","solve",
-		"specify","specparam","static","strength","string","strong","strong0",
-		"strong1","struct","super","supply0","supply1","sync_accept_on","sync_reject_on",
-		"table","tagged","task","this","throughout","time","timeprecision",
-		"timeunit","tran","tranif0","tranif1","tri","tri0","tri1",
-		"triand","trior","trireg","type","typedef","union","unique",
-		"unique0","unsigned","until","until_with","untyped","use","uwire",
-		"var","vectored","virtual","void","wait","wait_order","wand",
-		"weak","weak0","weak1","while","wildcard","wire","with",
-		"within","wor","xnor","xor",""};
-	    for (const char** k=kwds; **k; k++) s_map.insert(*k);
-	}
+	static const set<string> s_map = keywordSet();
 	string str(kwd,leng);
 	return s_map.end() != s_map.find(str);
     }
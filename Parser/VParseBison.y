@@ -34,6 +34,7 @@
 #include <cerrno>
 #include <cstdlib>
 #include <climits>
+#include <new>
 
 #include "VParse.h"
 #include "VParseGrammar.h"
@@ -47,8 +48,9 @@
 
 //*************************************************************************
 
-#define GRAMMARP VParseGrammar::staticGrammarp()
-#define PARSEP VParseGrammar::staticParsep()
+// The parser is pure; actions get the grammar as the %parse-param
+#define GRAMMARP grammarp
+#define PARSEP (grammarp->parsep())
 
 #define NEWSTRING(text) (string((text)))
 #define SPACED(a,b)	((a)+(((a)=="" || (b)=="")?"":" ")+(b))
@@ -77,7 +79,7 @@
 
 enum net_idx {NI_NETNAME = 0, NI_MSB, NI_LSB};
 
-static void VARDONE(VFileLine * fl, const string& name, const string& array, const string& value) {
+static void VARDONE(VParseGrammar* grammarp, VFileLine * fl, const string& name, const string& array, const string& value) {
     if (GRAMMARP->m_var.m_io != "" && GRAMMARP->m_var.m_decl == "")
         GRAMMARP->m_var.m_decl = "port";
     if (GRAMMARP->m_var.m_decl != "") {
@@ -93,14 +95,14 @@ static void VARDONE(VFileLine * fl, const string& name, const string& array, con
     }
 }
 
-static void VARDONETYPEDEF(VFileLine* fl, const string& name, const string& type, const string& array) {
+static void VARDONETYPEDEF(VParseGrammar* grammarp, VFileLine* fl, const string& name, const string& type, const string& array) {
     VARRESET(); VARDECL("typedef"); VARDTYPE(type);
-    VARDONE(fl,name,array,"");
+    VARDONE(grammarp, fl,name,array,"");
     // TYPE shouldn't override a more specific node type, as often is forward reference
     PARSEP->syms().replaceInsert(VAstType::TYPE, name);
 }
 
-static void parse_net_constants(VFileLine* fl, VParseHashElem nets[][3]) {
+static void parse_net_constants(VParseGrammar* grammarp, VFileLine* fl, VParseHashElem nets[][3]) {
     VParseHashElem (*net)[3] = &nets[0];
     VParseHashElem* nhp = net[0];
 
@@ -206,7 +208,7 @@ static void parse_net_constants(VFileLine* fl, VParseHashElem nets[][3]) {
     }
 }
 
-static void PINDONE(VFileLine* fl, const string& name, const string& expr) {
+static void PINDONE(VParseGrammar* grammarp, VFileLine* fl, const string& name, const string& expr) {
     if (GRAMMARP->m_cellParam) {
 	// Stack them until we create the instance itself
 	GRAMMARP->m_pinStack.push_back(VParseGPin(fl, name, expr, GRAMMARP->pinNum()));
@@ -244,7 +246,7 @@ static void PINDONE(VFileLine* fl, const string& name, const string& expr) {
 
 		unsigned int arraycnt = GRAMMARP->m_portStack.size();
 		VParseHashElem nets[arraycnt][3];
-		parse_net_constants(fl, nets);
+		parse_net_constants(grammarp, fl, nets);
 		PARSEP->pinselectsCb(fl, name, arraycnt, 3, &nets[0][0], GRAMMARP->pinNum());
 	    }
 	    // Clear all pin-related fields
@@ -257,7 +259,7 @@ static void PINDONE(VFileLine* fl, const string& name, const string& expr) {
     }
 }
 
-static void PINPARAMS() {
+static void PINPARAMS(VParseGrammar* grammarp) {
     // Throw out all the "pins" we found before we could do instanceCb
     while (!GRAMMARP->m_pinStack.empty()) {
 	VParseGPin& pinr = GRAMMARP->m_pinStack.front();
@@ -267,7 +269,7 @@ static void PINPARAMS() {
     GRAMMARP->m_withinPin = true;
 }
 
-static void PORTNET(VFileLine* fl, const string& name) {
+static void PORTNET(VParseGrammar* grammarp, VFileLine* fl, const string& name) {
     if (!GRAMMARP->m_withinInst) {
         return;
     }
@@ -277,7 +279,7 @@ static void PORTNET(VFileLine* fl, const string& name) {
     GRAMMARP->m_portNextNetLsb.clear();
 }
 
-static void PORTRANGE(const string& msb, const string& lsb) {
+static void PORTRANGE(VParseGrammar* grammarp, const string& msb, const string& lsb) {
     if (!GRAMMARP->m_withinInst) {
         return;
     }
@@ -285,7 +287,7 @@ static void PORTRANGE(const string& msb, const string& lsb) {
     GRAMMARP->m_portNextNetLsb = lsb;
 }
 
-static void PIN_CONCAT_APPEND(const string& expr) {
+static void PIN_CONCAT_APPEND(VParseGrammar* grammarp, const string& expr) {
     if (!GRAMMARP->m_withinPin) {
         return;
     }
@@ -310,14 +312,12 @@ static void PIN_CONCAT_APPEND(const string& expr) {
 }
 
 /* Yacc */
-static int  VParseBisonlex(VParseBisonYYSType* yylvalp) { return PARSEP->lexToBison(yylvalp); }
+static void VParseBisonerror(VParseGrammar* grammarp, const char *s) { PARSEP->error(s); }
 
-static void VParseBisonerror(const char *s) { VParseGrammar::bisonError(s); }
-
-static void ERRSVKWD(VFileLine* fileline, const string& tokname) {
-    static int toldonce = 0;
+static void ERRSVKWD(VParseGrammar* grammarp, VFileLine* fileline, const string& tokname) {
     fileline->error((string)"Unexpected \""+tokname+"\": \""+tokname+"\" is a SystemVerilog keyword misused as an identifier.");
-    if (!toldonce++) fileline->error("Modify the Verilog-2001 code to avoid SV keywords, or use `begin_keywords or --language.");
+    if (!grammarp->m_svKwdTold) fileline->error("Modify the Verilog-2001 code to avoid SV keywords, or use `begin_keywords or --language.");
+    grammarp->m_svKwdTold = true;
 }
 
 static void NEED_S09(VFileLine*, const string&) {
@@ -325,10 +325,24 @@ static void NEED_S09(VFileLine*, const string&) {
     //fileline->error((string)"Advanced feature: \""+tokname+"\" is a 1800-2009 construct, but used under --language 1800-2005 or earlier.");
 }
 
+// Actions call the above without passing the grammar
+#define VARDONE(fl,name,array,value) VARDONE(grammarp,(fl),(name),(array),(value))
+#define VARDONETYPEDEF(fl,name,type,array) VARDONETYPEDEF(grammarp,(fl),(name),(type),(array))
+#define PINDONE(fl,name,expr) PINDONE(grammarp,(fl),(name),(expr))
+#define PINPARAMS() PINPARAMS(grammarp)
+#define PORTNET(fl,name) PORTNET(grammarp,(fl),(name))
+#define PORTRANGE(msb,lsb) PORTRANGE(grammarp,(msb),(lsb))
+#define PIN_CONCAT_APPEND(expr) PIN_CONCAT_APPEND(grammarp,(expr))
+#define ERRSVKWD(fileline,tokname) ERRSVKWD(grammarp,(fileline),(tokname))
+
 %}
 
+%parse-param {VParseGrammar* grammarp}
+
 BISONPRE_VERSION(0.0, 2.999, %pure_parser)
 BISONPRE_VERSION(3.0,        %pure-parser)
+BISONPRE_VERSION(2.4, 2.999, %define api.push_pull "push")
+BISONPRE_VERSION(3.0,        %define api.push-pull push)
 BISONPRE_VERSION(0.0, 2.999, %token_table)
 BISONPRE_VERSION(3.0,        %token-table)
 BISONPRE_VERSION(2.4, 2.999, %define lr.keep_unreachable_states)
@@ -4973,14 +4987,36 @@ constraintStaticE:		// IEEE: part of extern_constraint_declaration
 //**********************************************************************
 %%
 
-int VParseGrammar::parse() {
-    s_grammarp = this;
-    return VParseBisonparse();
+bool VParseGrammar::parse() {
+    // Push tokens from the lexer until the parse completes, or, when
+    // parsing incrementally, the lexer has used all the input so far.
+    if (!m_pstatep) pstateNew();
+    VParseBisonYYSType yylval;  // Reused like yyparse's, the lexer needn't set all fields
+    int status;
+    do {
+	int tok = m_parsep->lexToBison(&yylval);
+	if (!tok && m_parsep->lexSuspended()) return false;
+	status = VParseBisonpush_parse(m_pstatep, tok, &yylval, this);
+    } while (status == YYPUSH_MORE);
+    pstateDelete();
+    return true;
+}
+void VParseGrammar::pstateNew() {
+    // Bison allocates the state with malloc, so the value stack, which
+    // yyparse would have as a local array, needs constructing
+    m_pstatep = VParseBisonpstate_new();
+    for (int i=0; i<YYINITDEPTH; ++i) new (&m_pstatep->yyvsa[i]) VParseBisonYYSType();
+}
+void VParseGrammar::pstateDelete() {
+    if (!m_pstatep) return;
+    for (int i=0; i<YYINITDEPTH; ++i) m_pstatep->yyvsa[i].~VParseBisonYYSType();
+    VParseBisonpstate_delete(m_pstatep);
+    m_pstatep = NULL;
 }
 void VParseGrammar::debug(int level) {
     VParseBisondebug = level;
 }
-const char* VParseGrammar::tokenName(int token) {
+string VParseGrammar::tokenName(int token) {
 #if YYDEBUG || YYERROR_VERBOSE
     if (token >= 255) {
 	switch (token) {
@@ -4988,8 +5024,7 @@ const char* VParseGrammar::tokenName(int token) {
 	default: return yytname[token-255];
 	}
     } else {
-	static char ch[2];  ch[0]=token; ch[1]='\0';
-	return ch;
+	return string(1, (char)token);
     }
 #else
     return "";
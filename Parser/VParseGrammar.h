@@ -75,9 +75,11 @@ struct VParseBisonYYSType {
 
 //============================================================================
 
+struct VParseBisonpstate;
+
 class VParseGrammar {
-    static VParseGrammar*	s_grammarp;	///< Current THIS, bison() isn't class based
     VParse*	   m_parsep;
+    VParseBisonpstate* m_pstatep;	///< Bison push parser state, NULL between parses
     //int debug() { return 9; }
 
 public: // Only for VParseBison
@@ -95,32 +97,27 @@ public: // Only for VParseBison
 
     bool	m_withinPin;
     bool	m_withinInst;
+    bool	m_svKwdTold;		///< Explained SV keywords used as identifiers
 
     deque<VParseGPin>	m_pinStack;
     deque<VParseNet>	m_portStack;
     deque<VParseVar>	m_varStack;
 
 public: // But for internal use only
-    static VParseGrammar* staticGrammarp() { return s_grammarp; }
-    static VParse* staticParsep() { return staticGrammarp()->m_parsep; }
-
-    static void bisonError(const char* text) {
-	staticParsep()->error(text);
-    }
-    //static VFileLine* fileline() { return s_grammarp->m_fileline; }
+    VParse* parsep() const { return m_parsep; }
 
 public:
     // CREATORS
-    VParseGrammar(VParse* parsep) : m_parsep(parsep) {
-	s_grammarp = this;
+    VParseGrammar(VParse* parsep) : m_parsep(parsep), m_pstatep(NULL) {
 	m_pinNum = 0;
 	m_cellParam = false;
 	m_portNextNetValid = false;
 	m_withinInst = false;
 	m_withinPin = false;
+	m_svKwdTold = false;
     }
     ~VParseGrammar() {
-	s_grammarp = NULL;
+	pstateDelete();
     }
 
     // ACCESSORS
@@ -130,8 +127,15 @@ public:
     void pinNumInc() { m_pinNum++; }
 
     // METHODS
-    int parse();  // See VParseBison.y
-    static const char* tokenName(int token);
+    /// Parse tokens until the end of input and return true, or, if the
+    /// lexer is suspended waiting for more input, return false to be
+    /// called again.  See VParseBison.y
+    bool parse();
+private:
+    void pstateNew();
+    void pstateDelete();
+public:
+    static string tokenName(int token);
 };
 
 #endif // Guard
@@ -31,40 +31,8 @@
 #include "VParseGrammar.h"
 
 //======================================================================
-// Externs created by flex
-// We add a prefix so that other lexers/flexers in the same program won't collide.
-#ifndef yy_create_buffer
-# define yy_create_buffer VParseLex_create_buffer
-# define yy_delete_buffer VParseLex_delete_buffer
-# define yy_scan_buffer VParseLex_scan_buffer
-# define yy_scan_string VParseLex_scan_string
-# define yy_scan_bytes VParseLex_scan_bytes
-# define yy_flex_debug VParseLex_flex_debug
-# define yy_init_buffer VParseLex_init_buffer
-# define yy_flush_buffer VParseLex_flush_buffer
-# define yy_load_buffer_state VParseLex_load_buffer_state
-# define yy_switch_to_buffer VParseLex_switch_to_buffer
-# define yyin VParseLexin
-# define yyleng VParseLexleng
-# define yylex VParseLexlex
-# define yyout VParseLexout
-# define yyrestart VParseLexrestart
-# define yytext VParseLextext
-#endif
-
-#ifndef YY_BUFFER_STATE
-struct yy_buffer_state;
-typedef struct yy_buffer_state *YY_BUFFER_STATE;
-# define YY_BUF_SIZE 16384
-#endif
-
-extern int yylex();
-extern void yyrestart(FILE*);
-
-YY_BUFFER_STATE yy_create_buffer (FILE *file, int size);
-YY_BUFFER_STATE yy_scan_bytes(const char *bytes, int len);
-void yy_switch_to_buffer(YY_BUFFER_STATE new_buffer);
-void yy_delete_buffer(YY_BUFFER_STATE b);
+// The lexer is reentrant, so flex's functions are only called from
+// VParseLex.l, with the scanner state each VParseLex holds.
 
 class VParse;
 
@@ -84,32 +52,18 @@ class VParseLex {
     int		m_pvstate;		///< "pure virtual" detection
 
     // Parse state
-    YY_BUFFER_STATE  m_yyState;	///< flex input state
+    void*	m_yyscanner;		///< flex reentrant scanner state, a yyscan_t
 
     // State to lexer
-    static VParseLex* s_currentLexp;	///< Current lexing point
-    static VParseBisonYYSType* s_yylvalp;
+    VParseBisonYYSType* m_yylvalp;	///< Value of the token being lexed
     int	prevLexToken() { return m_prevLexToken; } // Parser -> lexer communication
 
     // CONSTRUCTORS
-    VParseLex(VParse* parsep) {
-	m_parsep = parsep;
-	m_inCellDefine = false;
-	m_prevLexToken = 0;
-	m_ahead = false;
-	m_pvstate = 0;
-
-	m_yyState = yy_create_buffer(NULL, YY_BUF_SIZE);
-	s_currentLexp = this;
-	yyrestart(NULL);
-	debug(0);
-    }
-    ~VParseLex() {
-	yy_delete_buffer(m_yyState);
-	s_currentLexp = NULL;
-    }
+    VParseLex(VParse* parsep);
+    ~VParseLex();
 
-    void restart() { yyrestart(NULL); }
+    void restart();
+    void errorf(const char* format, ...);
 
     // Internal Utilities
     static bool symEscapeless(const char* textp, size_t leng) {
@@ -75,13 +75,6 @@ extern "C" {
 # include "XSUB.h"
 }
 
-//######################################################################
-// VAstEnt
-//
-// A symtable is simply a hash(HV) by name of the object
-// Under each hash entry (HE) is an array (AV)
-// Under each array (AV) is an [SV with type, SV with HV of lower symtab]
-
 #if 0
 # define DBG_UINFO(z,msg) {printf("%s:%d: ", __FILE__,__LINE__); cout << msg; }
 #else
@@ -93,8 +86,8 @@ extern "C" {
 
 VSymStack::VSymStack(VFileLine* fl, struct av* symp) {
     assert(symp);
-    ((VAstEnt*)(symp))->initNetlist(fl);
-    pushScope((VAstEnt*)(symp));
+    m_tablep = VAstTable::fromAV(fl, symp);
+    pushScope(m_tablep->netlistp());
 }
 
 //######################################################################
@@ -161,8 +154,27 @@ void VSymStack::selftest() {
 	DBG_UINFO(9,"=============\n");
 	assert(stack.findTypeUpward("a") == VAstType::TYPE);
     }
+
+    DBG_UINFO(9,"=============\n");
+    {
+	// Same table from the same array; another from the array's contents
+	VSymStack same(fl, topavp);
+	assert(same.findTypeUpward("top") == VAstType::PACKAGE);
+	AV* copyavp = newAV();
+	stack.tablep()->exportAV(copyavp);
+	AV* copy2avp = av_make(av_len(copyavp)+1, AvARRAY(copyavp));
+	VSymStack copy(fl, copy2avp);
+	assert(copy.tablep() != stack.tablep());
+	VAstEnt* topp = copy.netlistSymp()->findSym("top");
+	assert(topp && topp->type() == VAstType::PACKAGE);
+	assert(topp->findSym("lower")->findSym("a")->type() == VAstType::CLASS);
+	assert(topp->findSym("lower")->findSym("a")->parentp() == topp->findSym("lower"));
+	if (topp) {}  // Unused when assert is compiled out
+	SvREFCNT_dec(copyavp);
+	SvREFCNT_dec(copy2avp);
+    }
     //
-    av_undef(topavp); topavp=NULL;
+    SvREFCNT_dec(topavp); topavp=NULL;  // Table freed with stack
 };
 
 #undef DBG_UINFO
@@ -38,15 +38,17 @@ class VSymStack {
 
     SymStack		m_sympStack;	// Stack of symbol tables
     VAstEnt*		m_currentSymp;	// Current symbol table
+    VAstTable*		m_tablep;	// Tree of all symbol tables, referenced
 
 public:
     // CONSTRUCTORS
     VSymStack(VFileLine* fl, struct av* symp);	// Pass in top-level symbol table array
-    ~VSymStack() {}
+    ~VSymStack() { m_tablep->unref(); }
 
     // ACCESSORS
     VAstEnt* currentSymp() const { return m_currentSymp; }
     VAstEnt* netlistSymp() const { return m_sympStack.front(); }
+    VAstTable* tablep() const { return m_tablep; }
 
     // METHODS
     /// Insert a new entry, and return the new entry
@@ -76,8 +78,10 @@ public:
     /// Lookup the given string as an identifier, return type of the id
     // This recurses upwards if not found; for flat lookup use symp->findSym
     VAstEnt* findEntUpward(const string& name) {
+	int nameId = m_tablep->names().find(name);
+	if (nameId < 0) return NULL;  // Not declared in any scope
 	for (VAstEnt* symp=currentSymp(); symp; symp=symp->parentp()) {
-	    if (VAstEnt* subp = symp->findSym(name)) {
+	    if (VAstEnt* subp = symp->findSymId(nameId)) {
 		return subp;
 	    }
 	}
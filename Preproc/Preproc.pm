@@ -27,19 +27,51 @@ bootstrap Verilog::Preproc;
 # sub filename (class)
 # sub lineno (class)
 # sub unreadback (class, text)
+# sub sync_defines (class)
+# sub stats (class)
+# sub _profile (class, flag)
+# sub _define_use (class, flag)
+# sub define_uses (class)
+# sub _native_defines (class, flag)
+# sub _pipeline (class, flag)
+# sub _lookahead_start (class, include_native)
+# sub _lookahead_commit (class)
+# sub _line_map (class, flag)
+# sub _insert_text (class, text)
+# sub _cache_record (class, flag)
+# sub _cache_result (class)
+# sub _include_path (class, dirs, exts)
+# sub _resolve_file (class, filename)
+# sub _snapshot (class)
+# sub _snapshot_restore (class, data)
+# sub _write_fd (class, fd)
+# sub _write_flush (class, fd)
+# sub _prepass_rate (bytes)
+# sub _prepass_strip (text, bytewise)
+# sub _def_define/_def_undef/_def_undefineall/_def_params/_def_value (class, ...)
+# sub _def_changed (class, name)
+# sub _define_templates (class, flag)
 
 ######################################################################
 #### Accessors
 
 sub new {
     my $class = shift;  $class = ref $class if ref $class;
-    my $self = {keep_comments=>1,
+    my $self = {cache_dir=>undef,
+		cache_size=>256*1024*1024,
+		define_uses=>0,
+		keep_comments=>1,
 		keep_whitespace=>1,
 		line_directives=>1,
+		line_map=>0,
 		ieee_predefined=>1,
 		pedantic=>0,
 		synthesis=>0,
 		options=>Verilog::Getopt->new(),	# If the user didn't give one, still work!
+		native_defines=>0,
+		native_file_path=>0,
+		pipeline=>0,
+		profile=>0,
 		parent => undef,
 		#include_open_nonfatal=>0,
 		@_};
@@ -54,6 +86,15 @@ sub new {
 		$self->{pedantic},
 		$self->{synthesis},
 		);
+    $self->_profile(1) if $self->{profile};
+    $self->_define_use(1) if $self->{define_uses};
+    $self->_pipeline(1) if $self->{pipeline};
+    $self->_line_map(1) if $self->{line_map};
+    if ($self->{native_defines} && $self->_native_defines_ok) {
+	$self->{_native_defines} = $self->_native_defines(1);
+    }
+    $self->_define_templates(0) if !$self->_define_templates_ok;
+    $self->{_native_file_path} = 1 if $self->{native_file_path} && $self->_native_file_path_ok;
     if ($self->{synthesis}) {
 	# Fourth argument 1 for cmdline - no `undefineall effect
 	$self->define('SYNTHESIS',1,undef,1);
@@ -81,6 +122,7 @@ sub new {
 
 sub DESTROY {
     my $self = shift;
+    $self->sync_defines if $self->{_native_defines} && $self->{_cthis};
     $self->_DESTROY;
 }
 
@@ -106,19 +148,85 @@ sub open {
     my $filename = $params{filename};
     $filename = $self->remove_defines($filename);
     printf ("Perl open $filename\n") if $self->{debug};
-    $filename = $self->{options}->file_path($filename);
+    my $name = $filename;
+    $filename = $self->_file_path($filename);
     printf ("Perl openfp $filename\n") if $self->{debug};
+    $self->{_cache}{paths}{$name} = $filename if $self->{_cache};
     if (!-r $filename) {
+	$self->{_cache}{files}{$filename} = '' if $self->{_cache};
 	if (!$params{open_nonfatal}) {
 	    $self->error("Cannot open $filename");
 	}
 	return undef;
     } else {
+	if ($self->{_cache}) {
+	    $self->{_cache}{files}{$filename} = _cache_file_md5($filename);
+	} elsif ($self->{cache_dir} && $self->eof && $self->_cache_ok) {
+	    return $self if $self->_cache_lookup($filename);
+	}
 	$self->_open($filename);
     }
     return $self;
 }
 
+sub snapshot_save {
+    my $self = shift;
+    my $filename = shift;
+    $self->{_native_defines} or croak "%Error: snapshot_save requires native_defines,";
+    my $data = $self->_snapshot;
+    # Write via a temporary, so other processes never see part of a file
+    my $tmp = "$filename.$$.tmp";
+    my $fh;
+    CORE::open($fh, ">", $tmp) or croak "%Error: $! $tmp,";
+    binmode $fh;
+    print $fh $data;
+    close $fh or croak "%Error: $! $tmp,";
+    rename($tmp, $filename) or croak "%Error: $! $filename,";
+    return $self;
+}
+
+sub snapshot_restore {
+    my $self = shift;
+    my $filename = shift;
+    return 0 if !$self->{_native_defines};
+    my $fh;
+    CORE::open($fh, "<", $filename) or return 0;
+    binmode $fh;
+    my $data = do { local $/; <$fh> };
+    close $fh;
+    my $why = $self->_snapshot_restore($data);
+    print "Snapshot $filename not restored: $why\n" if $self->{debug} && $why ne '';
+    return $why eq '' ? 1 : 0;
+}
+
+sub write_to {
+    my $self = shift;
+    my $to = shift;
+    # Write the rest of the output from C++ without passing through Perl
+    my $fh = $to;
+    my $opened = (!ref $to && ref(\$to) ne 'GLOB');
+    if ($opened) {
+	require IO::File;
+	$fh = IO::File->new(">$to") or croak "%Error: $! $to,";
+    }
+    my $fd = fileno($fh);
+    (defined $fd && $fd >= 0) or croak "%Error: write_to handle has no file descriptor,";
+    require IO::Handle;
+    IO::Handle::flush($fh);  # Perl's buffered output goes first
+    my $err = eval { $self->_write_fd($fd) };
+    if (!defined $err) {
+	# A callback died; first write the text before it, as getline would
+	my $died = $@;
+	$self->_write_flush($fd);
+	die $died;
+    }
+    croak "%Error: $err ".($opened ? $to : "writing fd $fd")."," if $err ne '';
+    if ($opened) {
+	$fh->close or croak "%Error: $! $to,";
+    }
+    return $self;
+}
+
 sub debug {
     my $self = shift;
     my $level = shift;
@@ -131,6 +239,359 @@ sub parent {
     return $self->{parent};
 }
 
+sub _native_defines_ok {
+    my $self = shift;
+    # The native define table only implements the standard define methods;
+    # if a subclass overrides any of them, keep calling the Perl methods.
+    return $self->_define_methods_standard(qw(define undef undefineall
+					      def_params def_value def_substitute));
+}
+
+sub _define_templates_ok {
+    my $self = shift;
+    # Compiled define values are kept until the define methods change them,
+    # which isn't known if a subclass keeps or computes defines itself.
+    return $self->_define_methods_standard(qw(define undef undefineall
+					      def_params def_value));
+}
+
+sub _define_methods_standard {
+    my $self = shift;
+    foreach my $method (@_) {
+	return 0 if $self->can($method) != Verilog::Preproc->can($method);
+    }
+    my $opt = $self->{options};
+    return 0 if !UNIVERSAL::isa($opt, 'Verilog::Getopt');
+    foreach my $method (qw(define undef undefineall defparams defvalue defvalue_nowarn)) {
+	return 0 if $opt->can($method) != Verilog::Getopt->can($method);
+    }
+    return 1;
+}
+
+sub _native_file_path_ok {
+    my $self = shift;
+    # The C++ resolver only implements the standard Verilog::Getopt lookup
+    my $opt = $self->{options};
+    return 0 if !UNIVERSAL::isa($opt, 'Verilog::Getopt');
+    foreach my $method (qw(file_path file_substitute incdir module_dir libext depend_files)) {
+	return 0 if $opt->can($method) != Verilog::Getopt->can($method);
+    }
+    return 1;
+}
+
+sub _file_path {
+    my $self = shift;
+    my $filename = shift;
+    # Same as options->file_path, but with native_file_path try the C++
+    # resolver first, which lists each directory once instead of statting
+    # every directory and extension
+    my $opt = $self->{options};
+    if ($self->{_native_file_path}) {
+	# Getopt replaces its file_path cache whenever the search paths change
+	$opt->{_file_path_cache} ||= {};
+	if (($self->{_include_path_cache}||0) != $opt->{_file_path_cache}) {
+	    $self->{_include_path_cache} = $opt->{_file_path_cache};
+	    $self->_include_path([map { $opt->file_substitute($_) } ($opt->incdir, $opt->module_dir)],
+				 [$opt->libext]);
+	}
+	my $found = $self->_resolve_file($filename);
+	if ($found ne '') {
+	    $opt->depend_files($found);
+	    return $found;
+	}
+    }
+    return $opt->file_path($filename);
+}
+
+######################################################################
+#### Lookahead
+# Preprocess later files on their own threads while earlier files are
+# parsed.  Each starts with the defines as they are when it is opened; at its
+# turn, if the defines it looked up have since changed it's opened again.
+
+sub _lookahead_each {
+    my %params = (filenames => [],
+		  threads => 1,
+		  # new => sub { return new preprocessor or undef },
+		  # each => sub { my ($filename, $pp_or_undef) = @_; },
+		  @_);
+    # Call each() on every file in order, with a preprocessor from new()
+    # already reading it, or undef if each() must open the file itself
+    my @files = @{$params{filenames}};
+    my @queue;
+    while (@files || @queue) {
+	while (@queue < $params{threads} && @files && $params{threads} > 1) {
+	    my $filename = shift @files;
+	    my $pp = $params{new}->($filename);
+	    $pp = undef if $pp && !$pp->_open_lookahead($filename);
+	    push @queue, [$filename, $pp];
+	}
+	push @queue, [shift @files, undef] if !@queue;
+	my ($filename, $pp) = @{shift @queue};
+	# Files before have finished, so the defines are now as if opened here
+	$pp = undef if $pp && !$pp->_lookahead_commit;
+	$params{each}->($filename, $pp);
+    }
+}
+
+sub _open_lookahead {
+    my $self = shift;
+    my $filename = shift;
+    # As open(), and start preprocessing on a thread; false if can't
+    return 0 if !$self->{_native_defines} || $self->{cache_dir};
+    return 0 if $filename =~ /^\`?[a-zA-Z_]\w*$/;  # Might be a define, see remove_defines
+    my $filepath = $self->_file_path($filename);
+    return 0 if !-r $filepath;
+    $self->_open($filepath);
+    $self->sync_defines;  # Predefined by new(), so not seen as changes
+    my $opt = $self->{options};
+    my $inc_native = ($self->{_native_file_path}
+		      && $self->can('include') == Verilog::Preproc->can('include')
+		      && $opt->can('includes') == Verilog::Getopt->can('includes'));
+    return $self->_lookahead_start($inc_native ? 1 : 0);
+}
+
+sub _include_native {
+    my $self = shift;
+    my ($from, $filename, $found) = @_;
+    # At EOF, for each `include that _lookahead_start let the C++ open
+    my $opt = $self->{options};
+    $opt->includes($from, $filename);
+    $opt->depend_files($found);
+}
+
+######################################################################
+#### Output cache
+# Results are found by a key hashing the top file and the options that
+# affect its output.  Each key's manifest lists the results seen, each with
+# the contents of the other files it opened and the define lookups it
+# depended on; the first whose dependencies still match is used.
+
+sub _cache_ok {
+    my $self = shift;
+    # Only the text and defines are stored, so nothing else may be observed
+    return 0 if $self->{keep_comments} eq '2';  # comment() callbacks
+    return 0 if $self->{define_uses};  # Needs each file actually read
+    foreach my $method (qw(comment include def_substitute)) {
+	return 0 if $self->can($method) != Verilog::Preproc->can($method);
+    }
+    return 1;
+}
+
+sub _cache_file_md5 {
+    my $filename = shift;
+    # Return hash of a file's contents, or '' if it can't be read
+    my $fh;
+    CORE::open($fh, "<", $filename) or return '';
+    binmode $fh;
+    my $md5 = Digest::MD5->new->addfile($fh)->hexdigest;
+    close $fh;
+    return $md5;
+}
+
+sub _cache_path {
+    my $self = shift;
+    my $hash = shift;
+    return $self->{cache_dir}."/".substr($hash,0,2)."/".$hash;
+}
+
+sub _cache_read {
+    my $filename = shift;
+    return undef if !-r $filename;
+    my $data = eval { Storable::retrieve($filename) };
+    utime(undef, undef, $filename) if $data;  # For _cache_trim
+    return $data;
+}
+
+sub _cache_write {
+    my $filename = shift;
+    my $data = shift;
+    # Write via a temporary, so other processes never see part of a file
+    (my $dir = $filename) =~ s!/[^/]+$!!;
+    eval { File::Path::mkpath($dir) } if !-d $dir;
+    my $tmp = "$filename.$$.tmp";
+    if (eval { Storable::nstore($data, $tmp) } && rename($tmp, $filename)) {
+	return 1;
+    }
+    unlink $tmp;
+    return 0;
+}
+
+sub _cache_lookup {
+    my $self = shift;
+    my $filename = shift;
+    # Insert a cached result for the file and return true, else start recording one
+    require Cwd;
+    require Digest::MD5;
+    require File::Path;
+    require Storable;
+    my $opt = $self->{options};
+    my $md5 = _cache_file_md5($filename);
+    return 0 if $md5 eq '';
+    my $key = Digest::MD5::md5_hex
+	(join("\0", "Verilog::Preproc", $VERSION, ref($self), ref($opt), Cwd::getcwd(), $filename, $md5,
+	      (map { defined $self->{$_} ? $self->{$_} : "" }
+	       qw(keep_comments keep_whitespace line_directives pedantic synthesis
+		  ieee_predefined native_file_path include_open_nonfatal)),
+	      # Each search list, ended so directories can't move between them
+	      (map { ($opt->can($_) ? $opt->$_() : ()), "" } qw(incdir module_dir libext))));
+    my $manifest = _cache_read($self->_cache_path($key).".manifest") || [];
+    foreach my $ent (@{$manifest}) {
+	next if !$self->_cache_deps_match($ent);
+	my $result = _cache_read($self->_cache_path($ent->{result}).".result") or next;
+	$self->_cache_apply($result);
+	$self->{_cache_hits}++;
+	return 1;
+    }
+    $self->{_cache} = {key => $key,
+		       files => {},
+		       paths => {},
+		       includes => [],};
+    $self->_cache_record(1);
+    return 0;
+}
+
+sub _cache_deps_match {
+    my $self = shift;
+    my $ent = shift;
+    foreach my $filename (keys %{$ent->{files}}) {
+	return 0 if _cache_file_md5($filename) ne $ent->{files}{$filename};
+    }
+    return 0 if !$self->_cache_paths_match($ent->{paths});
+    foreach my $name (keys %{$ent->{params}}) {
+	my $val = $self->def_params($name);
+	return 0 if (defined $val ? $val : "") ne $ent->{params}{$name};
+    }
+    foreach my $name (keys %{$ent->{values}}) {
+	my $val = ($self->{_native_defines} ? $self->_def_value($name)
+		   : $self->{options}->defvalue_nowarn($name));
+	return 0 if (defined $val ? $val : "") ne $ent->{values}{$name};
+    }
+    return 1;
+}
+
+sub _cache_paths_match {
+    my $self = shift;
+    my $paths = shift;
+    # Each file opened must resolve to the same path, in case a file was
+    # added ahead of it in the search path
+    my $opt = $self->{options};
+    # Resolving adds to depend_files, which must only list files used
+    local $opt->{depend_files} = {%{$opt->{depend_files} || {}}} if UNIVERSAL::isa($opt, 'HASH');
+    foreach my $name (keys %{$paths}) {
+	return 0 if $self->_file_path($name) ne $paths->{$name};
+    }
+    return 1;
+}
+
+sub _cache_apply {
+    my $self = shift;
+    my $result = shift;
+    # Same effects as preprocessing the file
+    my $opt = $self->{options};
+    $opt->includes(@{$_}) foreach @{$result->{includes}};
+    $opt->depend_files(@{$result->{depend_files}}) if $opt->can('depend_files');
+    foreach my $name (sort keys %{$result->{writes}}) {
+	my $write = $result->{writes}{$name};
+	if ($write) {
+	    $self->define($name, @{$write});
+	} else {
+	    $self->undef($name);
+	}
+    }
+    $self->_insert_text($result->{text});
+}
+
+sub _cache_save {
+    my $self = shift;
+    # Called at EOF while recording, to store the result
+    my $rec = delete $self->{_cache} or return;
+    my $got = $self->_cache_result;
+    return if !$got->{ok};
+    my $result = {text => $got->{text},
+		  writes => $got->{writes},
+		  includes => $rec->{includes},
+		  depend_files => [sort grep { $rec->{files}{$_} ne '' } keys %{$rec->{files}}],};
+    my $ent = {files => $rec->{files},
+	       paths => $rec->{paths},
+	       params => $got->{params},
+	       values => $got->{values},};
+    {
+	local $Storable::canonical = 1;
+	$ent->{result} = Digest::MD5::md5_hex(Storable::nfreeze([$ent, $result]));
+    }
+    my $result_filename = $self->_cache_path($ent->{result}).".result";
+    my $grown = -(-s $result_filename || 0);
+    return if !_cache_write($result_filename, $result);
+    my $manifest_filename = $self->_cache_path($rec->{key}).".manifest";
+    my $manifest = _cache_read($manifest_filename) || [];
+    @{$manifest} = ($ent, grep { $_->{result} ne $ent->{result} } @{$manifest});
+    splice(@{$manifest}, 16) if $#{$manifest} >= 16;  # Keep most recent
+    $grown -= (-s $manifest_filename || 0);
+    _cache_write($manifest_filename, $manifest);
+    $grown += (-s $result_filename || 0) + (-s $manifest_filename || 0);
+    $self->_cache_trim($grown);
+}
+
+sub _define_uses_sync {
+    my $self = shift;
+    # Called at EOF, to merge the define uses into the options object
+    my $uses = $self->define_uses or return;
+    my $opt = $self->{options};
+    return if !$opt->can('define_uses');
+    $opt->define_uses($_, $uses->{files}{$_}) foreach keys %{$uses->{files}};
+    $opt->define_uses_inclusive($_, $uses->{tops}{$_}) foreach keys %{$uses->{tops}};
+}
+
+sub _cache_trim {
+    my $self = shift;
+    my $grown = shift;
+    # The cache's total size is kept in an index file, updated by each save
+    # under a lock, so the files are only listed when over cache_size
+    require Fcntl;
+    my $index_filename = $self->{cache_dir}."/size";
+    my $fh;
+    CORE::open($fh, "+>>", $index_filename) or return;
+    flock($fh, Fcntl::LOCK_EX());
+    seek($fh, 0, 0);
+    my $total = <$fh>;
+    if (defined $total && $total =~ /^(\d+)$/) {
+	$total = $1 + $grown;
+	$total = 0 if $total < 0;
+    } else {
+	$total = undef;  # New or damaged, so count the files
+    }
+    if (!defined $total || $total > $self->{cache_size}) {
+	$total = $self->_cache_trim_files($index_filename);
+    }
+    truncate($fh, 0);
+    print $fh "$total\n";
+    close $fh;
+}
+
+sub _cache_trim_files {
+    my $self = shift;
+    my $index_filename = shift;
+    # Remove least recently used files until under cache_size, return the size left
+    require File::Find;
+    my @files;
+    my $total = 0;
+    File::Find::find({no_chdir => 1,
+		      wanted => sub {
+			  return if $_ eq $index_filename;
+			  my @st = stat($_);
+			  return if !@st || !-f _;
+			  push @files, [$_, $st[7], $st[9]];
+			  $total += $st[7];
+		      }}, $self->{cache_dir});
+    return $total if $total <= $self->{cache_size};
+    foreach my $file (sort { $a->[2] <=> $b->[2] } @files) {
+	last if $total <= $self->{cache_size} * 0.9;
+	$total -= $file->[1] if unlink($file->[0]);
+    }
+    return $total;
+}
+
 ######################################################################
 #### Utilities
 
@@ -141,7 +602,11 @@ sub remove_defines {
     while (defined $val) {
 	last if $sym eq $val;
 	(my $xsym = $sym) =~ s/^\`//;
-	$val = $self->{options}->defvalue_nowarn($xsym);  #Undef if not found
+	if ($self->{_native_defines}) {
+	    $val = $self->_def_value($xsym);  #Undef if not found
+	} else {
+	    $val = $self->{options}->defvalue_nowarn($xsym);  #Undef if not found
+	}
 	$sym = $val if defined $val;
     }
     return $sym;
@@ -172,6 +637,7 @@ sub include {
     my ($self,$filename)=@_;
     print "INCLUDE $filename\n" if $self->{debug};
     $self->{options}->includes($self->filename, $filename);
+    push @{$self->{_cache}{includes}}, [$self->filename, $filename] if $self->{_cache};
     $self->open(filename => $filename,
 		open_nonfatal => $self->{include_open_nonfatal},
 		);
@@ -180,23 +646,33 @@ sub include {
 # Note rather than overriding these, a derived Verilog::Getopt class can
 # accomplish the same thing.
 
+# With native_defines these instead use a table in the C++ preprocessor,
+# which is stored back into the options at the end of the file.
+
 sub undef {
     my $self = shift;
+    return $self->_def_undef(@_) if $self->{_native_defines};
+    $self->_def_changed($_[0]);
     $self->{options}->undef(@_);
 }
 sub undefineall {
     my $self = shift;
+    return $self->_def_undefineall(@_) if $self->{_native_defines};
+    $self->_def_changed();
     $self->{options}->undefineall(@_);
 }
 sub define {
     my $self = shift;
     #print "DEFINE @_\n";
+    return $self->_def_define(@_) if $self->{_native_defines};
+    $self->_def_changed($_[0]);
     $self->{options}->fileline($self->filename.":".$self->lineno);
     $self->{options}->define(@_);
 }
 sub def_params {
     # Return define parameters
     my $self = shift;
+    return $self->_def_params(@_) if $self->{_native_defines};
     my $val = $self->{options}->defparams(@_);
     #printf "DEFPARAMS @_ -> %s\n", $val if $self->{debug};
     $val = "" if !defined $val;
@@ -206,6 +682,11 @@ sub def_value {
     # Return value
     my $self = shift;
     #printf "DEFVALUE @_ -> %s\n", $self->{options}->defvalue_nowarn(@_);
+    if ($self->{_native_defines}) {
+	my $val = $self->_def_value($_[0]);
+	(defined $val) or carp "%Warning: ".$self->fileline().": No definition for $_[0],";
+	return $val;
+    }
     return $self->{options}->defvalue(@_);
 }
 
@@ -258,6 +739,19 @@ parsing package to use for a new application.
 
 =over 4
 
+=item $self->define_uses()
+
+With the define_uses parameter, returns a reference to a hash with "files",
+a hash by filename of the defines consulted or changed directly by each
+file read, and "tops", the same for each top level file opened but also
+including the uses in every file it included.  Each use is a hash with
+"ifdef", a sorted list of the defines whose existence was tested by
+`ifdef, `ifndef, `elsif or an include guard; "value", those whose value or
+formals were substituted; "write", those set by `define or `undef; and
+"undefineall", true if `undefineall was used.  A guard test that skips an
+include is charged to the including file.  Returns undef without the
+define_uses parameter.
+
 =item $self->eof()
 
 Returns true at the end of the file.
@@ -296,28 +790,160 @@ that may be passed to new.
 
 =item $self->open(filename=>I<filename>)
 
-Opens the specified file.  If filename ends in .gz, decompress while
-reading.  If called before a file is completely parsed, the new file will
+Opens the specified file.  If the file is compressed with gzip, zstd or xz
+(determined from the file contents, or for pipes, a filename ending in .gz),
+decompress while reading.  Decompression is done in-process when the
+compression library was found at build time, else with the gunzip, zstd or
+xz program.  If called before a file is completely parsed, the new file will
 be parsed completely before returning to the previously open file.  (As if
 it was an include file.)
 
 Open may also be called without named parameters, in which case the only
 argument is the filename.
 
+=item $self->snapshot_restore(I<filename>)
+
+Restore the define table, and include guards, saved by snapshot_save.
+Returns true if restored.  Returns false, leaving the preprocessor
+unchanged, if the file cannot be read, was written by another version, any
+file read before it was saved has changed size, modification time or
+inode, or the command line defines (from +define+ or -D) differ.
+Requires native_defines.  Defines not on the command line are replaced by
+those in the snapshot.
+
+=item $self->snapshot_save(I<filename>)
+
+Save the define table, the include guards learned, and the identity of
+every file read so far into the given file.  Used like a precompiled
+header: after reading to the end of a prefix header included by every file,
+save a snapshot, and in later runs call snapshot_restore instead of reading
+the header; later includes of the header are then skipped by its include
+guard.  Requires native_defines.
+
+=item $self->stats()
+
+Returns a reference to a hash of statistics about this preprocessor.
+"include_guard_skips" is the number of includes that were skipped because
+the file was previously found to be entirely within a `ifndef include guard
+(`ifndef NAME ... `endif, with only whitespace outside) and NAME is still
+defined.  Skipped includes do not produce `line directives.
+"ifdef_skip_bytes" is the number of bytes of text disabled by `ifdef that
+were skipped over without being fully lexed.
+
+With the profile parameter, the hash also contains "files", a hash by
+filename of hashes with "opens", the number of times the file was opened;
+"bytes" and "tokens", the text read from the file, including from defines
+referenced in it; "skipped_bytes", the part of "bytes" disabled by `ifdef;
+"time_inclusive", the seconds spent in the file including the files it
+includes; and "time_exclusive", the seconds excluding included files.  It
+also contains "defines", a hash by define name of hashes with "count", the
+number of substitutions; "bytes", the total length of the substituted text;
+and "max_depth", the deepest nesting of define references seen when
+substituting it.  Times only include time spent inside getline and getall.
+
+=item $self->sync_defines()
+
+With native_defines, store the preprocessor's define table back into the
+options object.  This is done automatically at the end of the input, so is
+only needed to look at the options object's defines in the middle of a
+file.
+
 =item $self->unreadback(I<text>)
 
 Insert text into the input stream at the given point.  The text will not
 be parsed, just returned to the application.  This lets comment() callbacks
 insert special code into the output stream.
 
+=item $self->write_to(I<filehandle_or_filename>)
+
+Write all the remaining output to the given file handle, or create the
+given filename and write to it.  The text is written straight from the C++
+preprocessor in large writes, without passing through Perl, so is much
+faster than print of each getline on large inputs.  Callbacks are still
+made, and with the pipeline parameter preprocessing is done on a separate
+thread.  Anything printed before to a file handle is flushed first.
+
 =back
 
+=head1 INCLUDE CACHE
+
+The contents of included files are cached, and shared by all preprocessor
+objects in the process, so a header included by many files is only read
+and filtered once.  Files are recognized by name, device, inode, size and
+modification time, so changed files are read again.  The following class
+functions control the cache:
+
+=over 4
+
+=item Verilog::Preproc::include_cache_hash(I<flag>)
+
+With a true flag, files with identical contents share the same cache
+storage, at the cost of hashing each file read.  Returns the current
+setting.  Defaults to false.
+
+=item Verilog::Preproc::include_cache_limit(I<bytes>)
+
+Set the maximum number of bytes to cache, evicting the least recently used
+files to stay under the limit.  Zero disables the cache.  Returns the
+current limit; defaults to 64MB.
+
+=item Verilog::Preproc::include_cache_stats()
+
+Returns a hash reference of cache statistics: "hits" and "misses" are the
+number of opens satisfied by and not by the cache, "bytes_saved" the bytes
+not re-read due to hits, "evictions" the number of files removed to stay
+under the limit, and "entries", "bytes" and "limit" the current size.
+
+=item Verilog::Preproc::include_dir_cache_flush()
+
+Forget the directory listings read for native_file_path.
+
+=back
+
+=head1 OUTPUT CACHE
+
+With the cache_dir parameter, the preprocessed output of each file opened
+when no other file is being read is stored in that directory, and reused by
+later runs, including from other processes.  A stored result is reused when
+the file, the keep_comments, keep_whitespace, line_directives, pedantic,
+synthesis, ieee_predefined, native_file_path and include_open_nonfatal
+parameters, the current directory and the options' incdir, module_dir and
+libext lists are unchanged; each file it opened still resolves to the same
+path, and has the same contents; and every define it looked up before
+defining itself still has the same value.  Reusing a result returns the same
+text, and makes the same define changes, includes() and depend_files()
+calls on the options object as preprocessing the file would.  Warnings are
+not repeated, and filename() and lineno() are not updated.  Files that use
+`undefineall are not stored, and the cache is not used if comment() is
+called back, or the include or def_substitute methods are overridden.
+
+The total size of the directory is kept in its "size" file, so the
+directory is only listed when over cache_size.
+
 =head1 PARAMETERS
 
 The following named parameters may be passed to the new constructor.
 
 =over 4
 
+=item cache_dir=>I<directory>
+
+Store and reuse preprocessed output in the given directory, see OUTPUT
+CACHE.  Defaults undef, which disables the cache.
+
+=item cache_size=>I<bytes>
+
+With cache_dir, the maximum bytes to store in the directory, removing the
+least recently used results to stay under the limit.  Defaults to 256MB.
+
+=item define_uses=>1
+
+With define_uses set, record which defines each file consulted or changed;
+see define_uses().  At the end of input these are also merged into the
+options object's define_uses and define_uses_inclusive, next to its
+includes, so a build system can tell which files a define change affects.
+Disables the cache_dir lookup, as a cached result doesn't read the files.
+
 =item ieee_predefines=>0
 
 With ieee_predefines false, disable defining SV_COV_START and other IEEE
@@ -349,6 +975,42 @@ With line_directives set to zero, suppress "`line" comments which indicate
 filename and line number changes.  Use the lineno() and filename() methods
 instead to retrieve this information. Defaults true.
 
+=item line_map=>1
+
+With line_map set, when the preprocessor is read by
+Verilog::Parser::parse_preproc_file, the filename and line number changes
+are handed to the parser beside the text, rather than as "`line" directives
+the parser must lex, so the parser's locations are the same but the
+parser's preproc callback is not called for them.  Ignored when the
+preprocessor is read any other way, when text was already read, when
+keep_whitespace is zero, or when writing the cache_dir output cache.
+Defaults false.
+
+=item native_defines=>1
+
+With native_defines set, defines are loaded from the options object into a
+table inside the preprocessor the first time they are needed, and looked up
+there instead of calling the define methods for every define reference.
+The table is stored back into the options object at the end of the input,
+or when sync_defines() is called; until then the options object's defines
+are out of date.  This is ignored if the define, undef, undefineall,
+def_params, def_value or def_substitute callbacks are overridden, or the
+options object overrides the Verilog::Getopt define methods.  Defaults
+false.
+
+=item native_file_path=>1
+
+With native_file_path set, files are found by a resolver inside the
+preprocessor, which reads each include and module directory listing only
+once for the whole process, instead of checking each directory and libext
+combination for every include.  The results, including the file reported
+to the options' depend_files, are the same as from the options object's
+file_path, except that files created in a directory after it has been
+listed are only found if not in any other directory; use
+Verilog::Preproc::include_dir_cache_flush() to have directories listed
+again.  Ignored if the options object overrides the Verilog::Getopt
+file_path methods.  Defaults false.
+
 =item options=>Verilog::Getopt object
 
 Specifies the object to be used for resolving filenames and defines.  Other
@@ -362,6 +1024,27 @@ were added to the 1800-2009 standard.  It remains to disable `error and may
 disable other future features that are not specified in the language
 standard. Defaults false.
 
+=item pipeline=>1
+
+With pipeline set, when the preprocessor is read by
+Verilog::Parser::parse_preproc_file, preprocess on a separate thread while
+the parser consumes the text already produced.  Callbacks, including errors,
+are still called from the parsing thread, in the same order and at the same
+point in the text as without pipeline, but each such call stalls both
+threads.  So it only pays off on a machine with more than one core, when few
+callbacks are made into Perl, that is with native_defines and
+native_file_path and no callbacks overridden; otherwise it is slower than
+without pipeline.  While the parse is in progress the preprocessor object
+must only be used from its callbacks, and no other preprocessor may be
+read.  A die in a callback stops the preprocessor and is rethrown from
+parse_preproc_file.  Ignored where threads are not available.  Defaults
+false.
+
+=item profile=>1
+
+With profile set, collect the per-file and per-define costs reported by
+stats().  Defaults false, and has no cost when false.
+
 =item synthesis=>1
 
 With synthesis set, define SYNTHESIS, and ignore text between "ambit",
@@ -394,7 +1077,11 @@ Called with each `undefineall.  Defaults to use options object.
 
 =item $self->define(I<defname>, I<value>, I<params>)
 
-Called with each `define.  Defaults to use options object.
+Called with each `define.  Defaults to use options object.  Define values
+are compiled when first substituted, so while a file is being read, change
+defines by calling define, undef or undefineall rather than through the
+options object.  Values aren't kept if def_params or def_value are
+overridden.
 
 =item $self->def_params(I<defname>)
 
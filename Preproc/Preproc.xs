@@ -28,7 +28,9 @@
 
 /* Mine: */
 #include "VPreProc.h"
+#include "VPreTextSource.h"
 #include <deque>
+#include <vector>
 
 /* Perl */
 extern "C" {
@@ -46,12 +48,46 @@ class VFileLineXs;
 #//**********************************************************************
 #// Preprocessor derived classes, so we can override the callbacks to call perl.
 
-class VPreProcXs : public VPreProc {
+class VPreProcXs : public VPreProc, public VPreTextSource {
 public:
     SV*		m_self;	// Class called from (the hash, not SV pointing to the hash)
     deque<VFileLineXs*> m_filelineps;
+    VPreDefTable* m_defTablep;	// Native define table, or NULL to call Perl for defines
+    bool	m_defLoaded;	// m_defTablep is loaded from options; options' copy is stale
+    bool	m_defWarnings;	// Verilog::Getopt define_warnings
+    bool	m_pipeline;	// readText preprocesses on a separate thread
+    bool	m_pipelineRunning;	// Pipeline thread started and not yet at EOF
+    bool	m_lineMapWanted;	// readText gives locations by nextLineMark
+    string	m_pipelineErr;	// $@ from a callback that died in pipeline mode
+    WriteBuf	m_writeBuf;	// Text being sent by write_to
 
-    VPreProcXs() : VPreProc() {}
+    // Recording for the preprocessed output cache, see Verilog::Preproc cache_dir
+    struct CacheWrite {
+	bool	m_defined;	// Else undefined
+	string	m_value;
+	string	m_params;
+    };
+    bool	m_cacheRecord;	// Recording text and defines
+    bool	m_cacheOk;	// Nothing seen that prevents caching the result
+    string	m_cacheText;	// Text returned while recording
+    map<string,string> m_cacheParams;	// First def_params of each define, if before a write
+    map<string,string> m_cacheValues;	// First def_value of each define, if before a write
+    map<string,CacheWrite> m_cacheWrites;	// Last write to each define
+
+    // Preprocessing ahead of the file before being finished, see lookaheadStart
+    struct NativeInclude {
+	string	m_from;		// File with the `include
+	string	m_filename;	// Name as given
+	string	m_found;	// Path opened
+    };
+    bool	m_lookahead;	// Started by lookaheadStart, and not yet committed
+    bool	m_includeNative;	// `include resolved here, without calling Perl include
+    vector<NativeInclude> m_nativeIncludes;	// Includes to tell Perl about at EOF
+
+    VPreProcXs() : VPreProc(), m_defTablep(NULL), m_defLoaded(false), m_defWarnings(false),
+		   m_pipeline(false), m_pipelineRunning(false), m_lineMapWanted(false),
+		   m_cacheRecord(false), m_cacheOk(false),
+		   m_lookahead(false), m_includeNative(false) {}
     virtual ~VPreProcXs();
 
     // Callback methods
@@ -67,6 +103,60 @@ public:
 
     void call(string* rtnStrp, int params, const char* method, ...);
     void unreadback(char* text);
+
+    // VPreTextSource, for Verilog::Parser::parse_preproc_file
+    void readStart();
+    virtual size_t readText(char* bufp, size_t max_size);
+    virtual bool nextLineMark(size_t fromLine, VPreLineMark& markr) {
+	return VPreProc::nextLineMark(fromLine, markr); }
+
+    // Output cache
+    void cacheRecord(bool flag);
+    void cacheConsult(map<string,string>& consultsr, const string& name, const string& result);
+    void cacheWrite(const string& name, bool defined, const string& value, const string& params);
+    void cacheText(const char* textp, size_t len) { if (m_cacheRecord) m_cacheText.append(textp, len); }
+    bool defRecording() const { return m_cacheRecord || m_lookahead; }
+    void eofSync();
+
+    // Lookahead, see Verilog::Preproc::_lookahead_each
+    bool lookaheadStart(bool includeNative);
+    bool lookaheadCommit();
+    bool includeNative(const string& filename);
+
+    // Native define table
+    void defNative(bool flag);
+    void defRead(VPreDefTable& defsr);
+    void defLoad();
+    void defSync();
+    void defDefine(const string& name, const string& value, const string* paramsp, bool cmdline);
+private:
+    HV* optionsHv();
+    HV* definesHv(bool create);
+};
+
+#//**********************************************************************
+#// Calls into Perl, which must be made on the thread that owns the interpreter.
+#// When preprocessing on a pipeline thread these are handed to the parsing thread.
+
+class VPreProcXsCall : public VPreProc::PipelineCall {
+public:
+    VPreProcXs*	m_preprocp;
+    string*	m_rtnStrp;	// If non-null, load return value here
+    const char*	m_method;	// Name of method to call
+    vector<const char*> m_args;	// Arguments to pass to method's @_
+    bool	m_eval;		// Trap die, and abort the pipeline
+    VPreProcXsCall(VPreProcXs* preprocp, string* rtnStrp, const char* method)
+	: m_preprocp(preprocp), m_rtnStrp(rtnStrp), m_method(method), m_eval(false) {}
+    virtual ~VPreProcXsCall() {}
+    virtual void run();
+};
+
+class VPreProcXsWarn : public VPreProc::PipelineCall {
+public:
+    string	m_msg;
+    VPreProcXsWarn(const string& msg) : m_msg(msg) {}
+    virtual ~VPreProcXsWarn() {}
+    virtual void run() { warn("%s", m_msg.c_str()); }
 };
 
 class VFileLineXs : public VFileLine {
@@ -92,7 +182,7 @@ public:
 #// Overrides error handling virtual functions to invoke callbacks
 
 void VFileLineXs::error(const string& msg) {
-    static string holdmsg; holdmsg = msg;
+    string holdmsg = msg;
     m_vPreprocp->call(NULL, 1,"error",holdmsg.c_str());
 }
 
@@ -100,6 +190,8 @@ void VFileLineXs::error(const string& msg) {
 #// VPreProcXs functions
 
 VPreProcXs::~VPreProcXs() {
+    pipelineStop();  // Thread may still be using filelines
+    if (m_defTablep) { delete m_defTablep; m_defTablep = NULL; }
     for (deque<VFileLineXs*>::iterator it=m_filelineps.begin(); it!=m_filelineps.end(); ++it) {
 	delete *it;
     }
@@ -109,24 +201,36 @@ VPreProcXs::~VPreProcXs() {
 #// Overrides of virtual functions to invoke callbacks
 
 void VPreProcXs::comment(string cmt) {
-    static string holdcmt; holdcmt = cmt;
+    string holdcmt = cmt;
     call(NULL, 1,"comment",holdcmt.c_str());
 }
 void VPreProcXs::include(string filename) {
-    static string holdfilename; holdfilename = filename;
+    if (m_includeNative && includeNative(filename)) return;
+    string holdfilename = filename;
     call(NULL, 1,"include",holdfilename.c_str());
 }
 void VPreProcXs::undef(string define) {
-    static string holddefine; holddefine = define;
+    if (defRecording()) cacheWrite(define, false, "", "");
+    if (m_defTablep) { defLoad(); m_defTablep->undef(define); defineChanged(define); return; }
+    string holddefine = define;
     call(NULL, 1,"undef", holddefine.c_str());
 }
 void VPreProcXs::undefineall() {
+    m_cacheOk = false;  // Result would depend on every define
+    if (m_defTablep) { defLoad(); m_defTablep->undefineall(); defineChangedAll(); return; }
     call(NULL, 0,"undefineall");
 }
 void VPreProcXs::define(string define, string value, string params) {
-    static string holddefine; holddefine = define;
-    static string holdvalue; holdvalue = value;
-    static string holdparams; holdparams = params;
+    if (m_lookahead && m_defTablep && m_defWarnings) {
+	// Redefinition warning depends on the earlier value
+	defParams(define);
+	defValue(define);
+    }
+    if (defRecording()) cacheWrite(define, true, value, params);
+    if (m_defTablep) { defDefine(define, value, &params, false); return; }
+    string holddefine = define;
+    string holdvalue = value;
+    string holdparams = params;
     // 4th argument is cmdline; always undef from here
     call(NULL, 3,"define", holddefine.c_str(), holdvalue.c_str(), holdparams.c_str());
 }
@@ -134,19 +238,60 @@ bool VPreProcXs::defExists(string define) {
     return defParams(define)!="";
 }
 string VPreProcXs::defParams(string define) {
-    static string holddefine; holddefine = define;
     string paramStr;
-    call(&paramStr, 1,"def_params", holddefine.c_str());
+    if (m_defTablep) {
+	defLoad();
+	paramStr = m_defTablep->defParams(define);
+    } else {
+	string holddefine = define;
+	call(&paramStr, 1,"def_params", holddefine.c_str());
+    }
+    if (defRecording()) cacheConsult(m_cacheParams, define, paramStr);
     return paramStr;
 }
 string VPreProcXs::defValue(string define) {
-    static string holddefine; holddefine = define;
     string valueStr;
-    call(&valueStr, 1,"def_value", holddefine.c_str());
+    if (m_defTablep) {
+	defLoad();
+	valueStr = m_defTablep->defValue(define);
+    } else {
+	string holddefine = define;
+	call(&valueStr, 1,"def_value", holddefine.c_str());
+    }
+    if (defRecording()) cacheConsult(m_cacheValues, define, valueStr);
     return valueStr;
 }
+void VPreProcXs::readStart() {
+    // Before the first text is read
+    if (m_lineMapWanted) {
+	// Only once, and if refused the `line directives stay in the text.
+	// Text recorded for the output cache must keep its `line directives.
+	m_lineMapWanted = false;
+	if (!m_cacheRecord) lineMap(true);
+    }
+    if (m_pipeline && !m_pipelineRunning) {
+	if (m_defTablep) defLoad();  // Table must not touch Perl from the thread
+	m_pipelineRunning = pipelineStart();
+    }
+}
+size_t VPreProcXs::readText(char* bufp, size_t max_size) {
+    // As getall(), but called directly by a parser rather than through Perl
+    readStart();
+    size_t got = getText(bufp, max_size);
+    if (!got) {
+	m_pipelineRunning = false;
+	if (pipelineAborted()) {
+	    // Mortal, so nothing is left to free when croak unwinds
+	    croak_sv(sv_2mortal(newSVpvn(m_pipelineErr.data(), m_pipelineErr.length())));
+	}
+	eofSync();
+    }
+    cacheText(bufp, got);
+    return got;
+}
 string VPreProcXs::defSubstitute(string subs) {
-    static string holdsubs; holdsubs = subs;
+    if (m_defTablep) return subs;  // Native only used when def_substitute isn't overridden
+    string holdsubs = subs;
     string outStr;
     call(&outStr, 1, "def_substitute", holdsubs.c_str());
     return outStr;
@@ -159,50 +304,400 @@ void VPreProcXs::call(
     ...)		/* Arguments to pass to method's @_ */
 {
     // Call $perlself->method (passedparam1, parsedparam2)
+    VPreProcXsCall call(this, rtnStrp, method);
     va_list ap;
     va_start(ap, method);
-    {
-	dSP;				/* Initialize stack pointer */
-	ENTER;				/* everything created after here */
-	SAVETMPS;			/* ...is a temporary variable. */
-	PUSHMARK(SP);			/* remember the stack pointer */
-	SV* selfsv = newRV_inc(m_self);	/* $self-> */
-	XPUSHs(sv_2mortal(selfsv));
-
-	while (params--) {
-	    char* text = va_arg(ap, char *);
-	    SV* sv;
-	    if (text) {
-		sv = sv_2mortal(newSVpv(text, 0));
-	    } else {
-		sv = &PL_sv_undef;
-	    }
-	    XPUSHs(sv);			/* token */
+    while (params--) call.m_args.push_back(va_arg(ap, char *));
+    va_end(ap);
+    call.m_eval = pipelineThread();
+    pipelineCall(call);
+}
+
+void VPreProcXsCall::run() {
+    dSP;				/* Initialize stack pointer */
+    ENTER;				/* everything created after here */
+    SAVETMPS;				/* ...is a temporary variable. */
+    PUSHMARK(SP);			/* remember the stack pointer */
+    SV* selfsv = newRV_inc(m_preprocp->m_self);	/* $self-> */
+    XPUSHs(sv_2mortal(selfsv));
+
+    for (vector<const char*>::const_iterator it=m_args.begin(); it!=m_args.end(); ++it) {
+	const char* text = *it;
+	SV* sv;
+	if (text) {
+	    sv = sv_2mortal(newSVpv(text, 0));
+	} else {
+	    sv = &PL_sv_undef;
 	}
+	XPUSHs(sv);			/* token */
+    }
 
-	PUTBACK;			/* make local stack pointer global */
+    PUTBACK;				/* make local stack pointer global */
 
-	if (rtnStrp) {
-	    int rtnCount = perl_call_method((char*)method, G_SCALAR);
-	    SPAGAIN;			/* refresh stack pointer */
-	    if (rtnCount > 0) {
-		SV* sv = POPs;
-		//printf("RTN %ld %d %s\n", SvTYPE(sv),SvTRUE(sv),SvPV_nolen(sv));
+    I32 evalFlag = m_eval ? G_EVAL : 0;
+    if (m_rtnStrp) {
+	int rtnCount = perl_call_method((char*)m_method, G_SCALAR | evalFlag);
+	SPAGAIN;			/* refresh stack pointer */
+	if (rtnCount > 0) {
+	    SV* sv = POPs;
+	    //printf("RTN %ld %d %s\n", SvTYPE(sv),SvTRUE(sv),SvPV_nolen(sv));
 #ifdef SvPV_nolen	// Perl 5.6 and later
-		*rtnStrp = SvPV_nolen(sv);
+	    *m_rtnStrp = SvPV_nolen(sv);
 #else
-		*rtnStrp = SvPV(sv,PL_na);
+	    *m_rtnStrp = SvPV(sv,PL_na);
 #endif
+	}
+	PUTBACK;
+    } else {
+	perl_call_method((char*)m_method, G_DISCARD | G_VOID | evalFlag);
+    }
+    if (m_eval && SvTRUE(ERRSV)) {
+	// Died; stop preprocessing, and die from the parsing thread instead
+	m_preprocp->m_pipelineErr = SvPV_nolen(ERRSV);
+	m_abort = true;
+    }
+
+    FREETMPS;				/* free that return value */
+    LEAVE;				/* ...and the XPUSHed "mortal" args.*/
+}
+
+void VPreProcXs::eofSync() {
+    // At end of all input
+    for (vector<NativeInclude>::const_iterator it=m_nativeIncludes.begin(); it!=m_nativeIncludes.end(); ++it) {
+	call(NULL, 3, "_include_native", it->m_from.c_str(), it->m_filename.c_str(), it->m_found.c_str());
+    }
+    m_nativeIncludes.clear();
+    defSync();
+    if (defUse()) call(NULL, 0, "_define_uses_sync");
+    if (m_cacheRecord) {
+	m_cacheRecord = false;
+	call(NULL, 0, "_cache_save");
+    }
+}
+
+#//**********************************************************************
+#// Output cache recording
+#// The output depends on the first lookup of each define, unless the input
+#// itself defined it first, and changes the defines it last wrote.
+
+void VPreProcXs::cacheRecord(bool flag) {
+    m_cacheRecord = flag;
+    m_cacheOk = true;
+    m_cacheText.clear();
+    m_cacheParams.clear();
+    m_cacheValues.clear();
+    m_cacheWrites.clear();
+}
+
+void VPreProcXs::cacheConsult(map<string,string>& consultsr, const string& name, const string& result) {
+    if (m_cacheWrites.find(name) != m_cacheWrites.end()) return;
+    consultsr.insert(make_pair(name, result));  // Keeps the first
+}
+
+void VPreProcXs::cacheWrite(const string& name, bool defined, const string& value, const string& params) {
+    CacheWrite& ent = m_cacheWrites[name];
+    ent.m_defined = defined;
+    ent.m_value = value;
+    ent.m_params = params;
+}
+
+#//**********************************************************************
+#// Native define table
+#// Mirrors Verilog::Getopt's {defines} hash, where each value is either a
+#// plain value, or [value, params, cmdline] if there are params or cmdline is set.
+
+static bool perlTrue(const string* strp) {
+    // Perl truth of a string, NULL is undef
+    return strp && *strp != "" && *strp != "0";
+}
+
+static VPreDefTable::Entry defEntry(const string& value, const string* paramsp, bool cmdline) {
+    // Entry as Verilog::Getopt::define stores it
+    VPreDefTable::Entry ent;
+    ent.m_value = value;
+    if (perlTrue(paramsp) || cmdline) {
+	if (paramsp) { ent.m_params = *paramsp; ent.m_hasParams = true; }
+	ent.m_cmdline = cmdline;
+    }
+    return ent;
+}
+
+static bool getoptShortValue(const string& str) {
+    // Same as Verilog::Getopt::define's length($val)<40 && $val =~ /^[^\n\r\f]$/
+    // (yes, a single character, with an optional trailing newline)
+    if (str.length() < 1 || str.length() > 2) return false;
+    if (str.length() == 2 && str[1] != '\n') return false;
+    return str[0] != '\n' && str[0] != '\r' && str[0] != '\f';
+}
+
+HV* VPreProcXs::optionsHv() {
+    SV** svpp = hv_fetch((HV*)m_self, "options", 7, 0);
+    if (!svpp || !SvROK(*svpp) || SvTYPE(SvRV(*svpp)) != SVt_PVHV) return NULL;
+    return (HV*)SvRV(*svpp);
+}
+
+HV* VPreProcXs::definesHv(bool create) {
+    HV* optp = optionsHv();
+    if (!optp) return NULL;
+    SV** svpp = hv_fetch(optp, "defines", 7, 0);
+    if (svpp && SvROK(*svpp) && SvTYPE(SvRV(*svpp)) == SVt_PVHV) return (HV*)SvRV(*svpp);
+    if (!create) return NULL;
+    HV* defsp = newHV();
+    hv_store(optp, "defines", 7, newRV_noinc((SV*)defsp), 0);
+    return defsp;
+}
+
+void VPreProcXs::defNative(bool flag) {
+    if (flag && !m_defTablep) {
+	m_defTablep = new VPreDefTable;
+	m_defLoaded = false;
+    } else if (!flag && m_defTablep) {
+	defSync();
+	delete m_defTablep; m_defTablep = NULL;
+    }
+}
+
+void VPreProcXs::defLoad() {
+    // Bulk import from options, on first use
+    if (m_defLoaded) return;
+    m_defLoaded = true;
+    m_defWarnings = false;
+    if (HV* optp = optionsHv()) {
+	SV** svpp = hv_fetch(optp, "define_warnings", 15, 0);
+	m_defWarnings = svpp && SvTRUE(*svpp);
+    }
+    defRead(*m_defTablep/*ref*/);
+    defineChangedAll();  // Options may have changed since the last load
+}
+
+void VPreProcXs::defRead(VPreDefTable& defsr) {
+    // Load defsr from the options
+    defsr.clear();
+    HV* defsp = definesHv(false);
+    if (!defsp) return;
+    hv_iterinit(defsp);
+    while (HE* hep = hv_iternext(defsp)) {
+	I32 keylen;
+	char* keyp = hv_iterkey(hep, &keylen);
+	SV* valp = hv_iterval(defsp, hep);
+	VPreDefTable::Entry ent;
+	if (SvROK(valp) && SvTYPE(SvRV(valp)) == SVt_PVAV) {
+	    AV* avp = (AV*)SvRV(valp);
+	    SV** elpp;
+	    if ((elpp = av_fetch(avp, 0, 0)) && SvOK(*elpp)) ent.m_value = SvPV_nolen(*elpp);
+	    if ((elpp = av_fetch(avp, 1, 0)) && SvOK(*elpp)) {
+		ent.m_params = SvPV_nolen(*elpp);
+		ent.m_hasParams = true;
 	    }
-	    PUTBACK;
+	    ent.m_cmdline = (elpp = av_fetch(avp, 2, 0)) && SvTRUE(*elpp);
+	} else if (SvOK(valp)) {
+	    ent.m_value = SvPV_nolen(valp);
 	} else {
-	    perl_call_method((char*)method, G_DISCARD | G_VOID);
+	    continue;  // Undefined value is not defined
 	}
+	defsr.define(string(keyp, keylen), ent);
+    }
+}
 
-	FREETMPS;			/* free that return value */
-	LEAVE;				/* ...and the XPUSHed "mortal" args.*/
+void VPreProcXs::defSync() {
+    // Store the table back into options, which then becomes authoritative again
+    // Not while looking ahead, as the table may be stale
+    if (!m_defTablep || !m_defLoaded || m_lookahead) return;
+    m_defLoaded = false;
+    HV* defsp = definesHv(true);
+    if (defsp) {
+	hv_clear(defsp);
+	const VPreDefTable::DefMap& defs = m_defTablep->defs();
+	for (VPreDefTable::DefMap::const_iterator it=defs.begin(); it!=defs.end(); ++it) {
+	    const VPreDefTable::Entry& ent = it->second;
+	    SV* valp;
+	    if (ent.m_hasParams || ent.m_cmdline) {
+		AV* avp = newAV();
+		av_push(avp, newSVpvn(ent.m_value.c_str(), ent.m_value.length()));
+		av_push(avp, ent.m_hasParams ? newSVpvn(ent.m_params.c_str(), ent.m_params.length()) : newSV(0));
+		av_push(avp, ent.m_cmdline ? newSViv(1) : newSV(0));
+		valp = newRV_noinc((SV*)avp);
+	    } else {
+		valp = newSVpvn(ent.m_value.c_str(), ent.m_value.length());
+	    }
+	    hv_store(defsp, it->first.c_str(), it->first.length(), valp, 0);
+	}
     }
-    va_end(ap);
+    m_defTablep->clear();
+}
+
+void VPreProcXs::defDefine(const string& name, const string& value, const string* paramsp, bool cmdline) {
+    // Same as Verilog::Preproc::define calling Verilog::Getopt::define
+    defLoad();
+    if (m_defWarnings) {
+	const VPreDefTable::Entry* oldp = m_defTablep->find(name);
+	if (oldp) {
+	    string oldParams = perlTrue(oldp->m_hasParams ? &oldp->m_params : NULL) ? oldp->m_params : "";
+	    string newParams = perlTrue(paramsp) ? *paramsp : "";
+	    if (oldp->m_value != value || oldParams != newParams) {
+		ostringstream os;
+		os<<"%Warning: "<<fileline()->filename()<<":"<<fileline()->lineno()<<": Redefining `"<<name;
+		if (getoptShortValue(oldp->m_value) && getoptShortValue(value)) {
+		    os<<"to '"<<value<<"', was '"<<oldp->m_value<<"'";
+		}
+		os<<endl;
+		VPreProcXsWarn call(os.str());
+		pipelineCall(call);
+	    }
+	}
+    }
+    m_defTablep->define(name, defEntry(value, paramsp, cmdline));
+    defineChanged(name);
+}
+
+#//**********************************************************************
+#// Lookahead
+#// A file can be preprocessed while the files before it are still being
+#// parsed, with the defines as they were when it started.  The define
+#// lookups are recorded as for the output cache; when the earlier files
+#// finish, if those lookups still give the same results nothing could
+#// differ, and preprocessing continues with the final defines.
+
+bool VPreProcXs::lookaheadStart(bool includeNative) {
+    // Start preprocessing on a thread, before readText is called
+    if (!m_defTablep || m_cacheRecord) return false;
+    defLoad();
+    m_lookahead = true;
+    m_includeNative = includeNative;
+    m_cacheOk = true;
+    m_pipeline = true;
+    readStart();
+    return true;
+}
+
+bool VPreProcXs::lookaheadCommit() {
+    // The files before are finished.  Return true if the text so far is as
+    // if preprocessing started now, and have it continue as if it had.
+    if (!m_lookahead) return true;
+    pipelinePause();
+    VPreDefTable defs;
+    defRead(defs/*ref*/);
+    bool ok = m_cacheOk;
+    for (map<string,string>::const_iterator it=m_cacheParams.begin(); ok && it!=m_cacheParams.end(); ++it) {
+	ok = (defs.defParams(it->first) == it->second);
+    }
+    for (map<string,string>::const_iterator it=m_cacheValues.begin(); ok && it!=m_cacheValues.end(); ++it) {
+	ok = (defs.defValue(it->first) == it->second);
+    }
+    if (ok) {
+	// Same as the current defines followed by this file's changes
+	for (map<string,CacheWrite>::const_iterator it=m_cacheWrites.begin(); it!=m_cacheWrites.end(); ++it) {
+	    if (it->second.m_defined) {
+		defs.define(it->first, defEntry(it->second.m_value, &it->second.m_params, false));
+	    } else {
+		defs.undef(it->first);
+	    }
+	}
+	*m_defTablep = defs;
+	defineChangedAll();
+    }
+    m_lookahead = false;
+    m_cacheParams.clear();
+    m_cacheValues.clear();
+    m_cacheWrites.clear();
+    pipelineResume();
+    if (!ok) {
+	// Caller will discard us; the table must not be stored into options
+	pipelineStop();
+	m_pipelineRunning = false;
+	m_nativeIncludes.clear();
+	m_defLoaded = false;
+	m_defTablep->clear();
+    }
+    return ok;
+}
+
+bool VPreProcXs::includeNative(const string& filename) {
+    // As Verilog::Preproc::include, if it needs no Perl; else return false
+    // The filename might be a define, see Verilog::Preproc::remove_defines
+    if (filename.empty() || filename[0] == '`' || defExists(filename)) return false;
+    string found = resolveFile(filename);
+    if (found == "") return false;
+    NativeInclude inc;
+    inc.m_from = fileline()->filename();
+    inc.m_filename = filename;
+    inc.m_found = found;
+    m_nativeIncludes.push_back(inc);
+    openFile(found);
+    return true;
+}
+
+#//**********************************************************************
+#// Utilities
+
+static SV* statsNewRV(const map<string,size_t>& stats) {
+    // Return reference to a new hash of the given statistics
+    HV* hvp = newHV();
+    for (map<string,size_t>::const_iterator it=stats.begin(); it!=stats.end(); ++it) {
+	hv_store(hvp, it->first.c_str(), it->first.length(), newSVuv(it->second), 0);
+    }
+    return newRV_noinc((SV*)hvp);
+}
+
+static void avStrings(SV* svp, vector<string>& outr) {
+    // Append strings in the referenced array to outr
+    if (!SvROK(svp) || SvTYPE(SvRV(svp)) != SVt_PVAV) return;
+    AV* avp = (AV*)SvRV(svp);
+    for (I32 i=0; i<=av_len(avp); ++i) {
+	SV** elpp = av_fetch(avp, i, 0);
+	if (elpp && SvOK(*elpp)) outr.push_back(SvPV_nolen(*elpp));
+    }
+}
+
+static void statsStoreProfile(HV* hvp, const VPreProfile* profp) {
+    // Add "files" and "defines" hashes of the profile to the given statistics
+    HV* fileshvp = newHV();
+    for (VPreProfile::FileMap::const_iterator it=profp->files().begin(); it!=profp->files().end(); ++it) {
+	const VPreProfile::FileEnt& ent = it->second;
+	HV* enthvp = newHV();
+	hv_store(enthvp, "opens", 5, newSVuv(ent.m_opens), 0);
+	hv_store(enthvp, "bytes", 5, newSVuv(ent.m_bytes), 0);
+	hv_store(enthvp, "tokens", 6, newSVuv(ent.m_tokens), 0);
+	hv_store(enthvp, "skipped_bytes", 13, newSVuv(ent.m_skipBytes), 0);
+	hv_store(enthvp, "time_inclusive", 14, newSVnv(ent.m_inclSec), 0);
+	hv_store(enthvp, "time_exclusive", 14, newSVnv(ent.m_exclSec), 0);
+	hv_store(fileshvp, it->first.c_str(), it->first.length(), newRV_noinc((SV*)enthvp), 0);
+    }
+    hv_store(hvp, "files", 5, newRV_noinc((SV*)fileshvp), 0);
+    HV* defshvp = newHV();
+    for (VPreProfile::DefineMap::const_iterator it=profp->defines().begin(); it!=profp->defines().end(); ++it) {
+	const VPreProfile::DefineEnt& ent = it->second;
+	HV* enthvp = newHV();
+	hv_store(enthvp, "count", 5, newSVuv(ent.m_count), 0);
+	hv_store(enthvp, "bytes", 5, newSVuv(ent.m_bytes), 0);
+	hv_store(enthvp, "max_depth", 9, newSVuv(ent.m_maxDepth), 0);
+	hv_store(defshvp, it->first.c_str(), it->first.length(), newRV_noinc((SV*)enthvp), 0);
+    }
+    hv_store(hvp, "defines", 7, newRV_noinc((SV*)defshvp), 0);
+}
+
+static AV* avNewStrings(const set<string>& strs) {
+    // Return a new array of the given strings, in sorted order
+    AV* avp = newAV();
+    for (set<string>::const_iterator it=strs.begin(); it!=strs.end(); ++it) {
+	av_push(avp, newSVpv(it->c_str(), it->length()));
+    }
+    return avp;
+}
+
+static HV* defUseNewHV(const VPreDefUse::FileMap& files) {
+    // Return a new hash by filename of hashes of each file's define uses
+    HV* fileshvp = newHV();
+    for (VPreDefUse::FileMap::const_iterator it=files.begin(); it!=files.end(); ++it) {
+	const VPreDefUse::Uses& uses = it->second;
+	HV* enthvp = newHV();
+	hv_store(enthvp, "ifdef", 5, newRV_noinc((SV*)avNewStrings(uses.m_ifdefs)), 0);
+	hv_store(enthvp, "value", 5, newRV_noinc((SV*)avNewStrings(uses.m_values)), 0);
+	hv_store(enthvp, "write", 5, newRV_noinc((SV*)avNewStrings(uses.m_writes)), 0);
+	hv_store(enthvp, "undefineall", 11, newSViv(uses.m_undefineall ? 1 : 0), 0);
+	hv_store(fileshvp, it->first.c_str(), it->first.length(), newRV_noinc((SV*)enthvp), 0);
+    }
+    return fileshvp;
 }
 
 #//**********************************************************************
@@ -301,6 +796,78 @@ CODE:
     THIS->insertUnreadback((string)text);
 }
 
+#//**********************************************************************
+#// self->_insert_text(text)
+
+void
+VPreProcXs::_insert_text(text)
+SV* text
+PROTOTYPE: $$
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    STRLEN len;
+    const char* textp = SvPV(text, len);
+    THIS->insertText(string(textp, len));
+}
+
+#//**********************************************************************
+#// self->_cache_record(flag)
+
+void
+VPreProcXs::_cache_record(flag)
+int flag
+PROTOTYPE: $$
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    THIS->cacheRecord(flag);
+}
+
+#//**********************************************************************
+#// self->_cache_result()
+
+SV*
+VPreProcXs::_cache_result()
+PROTOTYPE: $
+CODE:
+{
+    // Return what was recorded, as {ok, text, params=>{name=>params},
+    // values=>{name=>value}, writes=>{name=>[value,params] or undef}}
+    if (!THIS) XSRETURN_UNDEF;
+    HV* hvp = newHV();
+    hv_store(hvp, "ok", 2, newSViv(THIS->m_cacheOk ? 1 : 0), 0);
+    hv_store(hvp, "text", 4, newSVpvn(THIS->m_cacheText.data(), THIS->m_cacheText.length()), 0);
+    const char* names[2] = {"params", "values"};
+    map<string,string>* mapps[2] = {&THIS->m_cacheParams, &THIS->m_cacheValues};
+    for (int i=0; i<2; ++i) {
+	HV* subhvp = newHV();
+	for (map<string,string>::const_iterator it=mapps[i]->begin(); it!=mapps[i]->end(); ++it) {
+	    hv_store(subhvp, it->first.c_str(), it->first.length(),
+		     newSVpvn(it->second.data(), it->second.length()), 0);
+	}
+	hv_store(hvp, names[i], strlen(names[i]), newRV_noinc((SV*)subhvp), 0);
+    }
+    HV* writeshvp = newHV();
+    for (map<string,VPreProcXs::CacheWrite>::const_iterator it=THIS->m_cacheWrites.begin();
+	 it!=THIS->m_cacheWrites.end(); ++it) {
+	SV* valp;
+	if (it->second.m_defined) {
+	    AV* avp = newAV();
+	    av_push(avp, newSVpvn(it->second.m_value.data(), it->second.m_value.length()));
+	    av_push(avp, newSVpvn(it->second.m_params.data(), it->second.m_params.length()));
+	    valp = newRV_noinc((SV*)avp);
+	} else {
+	    valp = newSV(0);
+	}
+	hv_store(writeshvp, it->first.c_str(), it->first.length(), valp, 0);
+    }
+    hv_store(hvp, "writes", 6, newRV_noinc((SV*)writeshvp), 0);
+    THIS->cacheRecord(false);
+    RETVAL = newRV_noinc((SV*)hvp);
+}
+OUTPUT: RETVAL
+
 #//**********************************************************************
 #// self->getall()
 
@@ -310,11 +877,11 @@ size_t approx_chunk
 PROTOTYPE: $;$
 CODE:
 {
-    static string holdline;
-    if (!THIS || THIS->isEof()) XSRETURN_UNDEF;
+    if (!THIS) XSRETURN_UNDEF;
+    if (THIS->isEof()) { THIS->eofSync(); XSRETURN_UNDEF; }
     string lastline = THIS->getall(approx_chunk);
-    holdline = lastline;	/* Stash it so c_str() doesn't disappear immediately */
-    if (holdline=="" && THIS->isEof()) XSRETURN_UNDEF;
+    if (lastline=="" && THIS->isEof()) { THIS->eofSync(); XSRETURN_UNDEF; }
+    THIS->cacheText(lastline.data(), lastline.length());
     RETVAL = newSVpv(lastline.c_str(), lastline.length());
 }
 OUTPUT: RETVAL
@@ -327,15 +894,50 @@ VPreProcXs::getline()
 PROTOTYPE: $
 CODE:
 {
-    static string holdline;
-    if (!THIS || THIS->isEof()) XSRETURN_UNDEF;
+    if (!THIS) XSRETURN_UNDEF;
+    if (THIS->isEof()) { THIS->eofSync(); XSRETURN_UNDEF; }
     string lastline = THIS->getline();
-    holdline = lastline;	/* Stash it so c_str() doesn't disappear immediately */
-    if (holdline=="" && THIS->isEof()) XSRETURN_UNDEF;
+    if (lastline=="" && THIS->isEof()) { THIS->eofSync(); XSRETURN_UNDEF; }
+    THIS->cacheText(lastline.data(), lastline.length());
     RETVAL = newSVpv(lastline.c_str(), lastline.length());
 }
 OUTPUT: RETVAL
 
+#//**********************************************************************
+#// self->_write_fd(fd)
+
+SV*
+VPreProcXs::_write_fd(fd)
+int fd
+PROTOTYPE: $$
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    string err = VPreProc::writeFd(THIS, fd, THIS->m_writeBuf);
+    RETVAL = newSVpv(err.c_str(), err.length());
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->_write_flush(fd)
+
+SV*
+VPreProcXs::_write_flush(fd)
+int fd
+PROTOTYPE: $$
+CODE:
+{
+    // After _write_fd died; also write the text getText was collecting
+    if (!THIS) XSRETURN_UNDEF;
+    VPreProc::WriteBuf& bufr = THIS->m_writeBuf;
+    string pending = THIS->getPending();
+    bufr.m_buf.replace(bufr.m_len, string::npos, pending);
+    bufr.m_len += pending.length();
+    string err = VPreProc::writeFlush(fd, bufr);
+    RETVAL = newSVpv(err.c_str(), err.length());
+}
+OUTPUT: RETVAL
+
 #//**********************************************************************
 #// self->eof()
 
@@ -348,6 +950,116 @@ CODE:
 }
 OUTPUT: RETVAL
 
+#//**********************************************************************
+#// self->stats()
+
+SV*
+VPreProcXs::stats()
+PROTOTYPE: $
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    map<string,size_t> stats;
+    THIS->stats(stats/*ref*/);
+    RETVAL = statsNewRV(stats);
+    if (const VPreProfile* profp = THIS->profile()) statsStoreProfile((HV*)SvRV(RETVAL), profp);
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->_profile(flag)
+
+void
+VPreProcXs::_profile(flag)
+int flag
+PROTOTYPE: $$
+CODE:
+{
+    THIS->profile(flag);
+}
+
+#//**********************************************************************
+#// self->_define_use(flag)
+
+void
+VPreProcXs::_define_use(flag)
+int flag
+PROTOTYPE: $$
+CODE:
+{
+    THIS->defUse(flag);
+}
+
+#//**********************************************************************
+#// self->define_uses()
+
+SV*
+VPreProcXs::define_uses()
+PROTOTYPE: $
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    const VPreDefUse* usep = THIS->defUse();
+    if (!usep) XSRETURN_UNDEF;
+    HV* hvp = newHV();
+    hv_store(hvp, "files", 5, newRV_noinc((SV*)defUseNewHV(usep->files())), 0);
+    hv_store(hvp, "tops", 4, newRV_noinc((SV*)defUseNewHV(usep->tops())), 0);
+    RETVAL = newRV_noinc((SV*)hvp);
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->_pipeline(flag)
+
+void
+VPreProcXs::_pipeline(flag)
+int flag
+PROTOTYPE: $$
+CODE:
+{
+    THIS->m_pipeline = flag;
+}
+
+#//**********************************************************************
+#// self->_lookahead_start(include_native)
+
+int
+VPreProcXs::_lookahead_start(include_native)
+int include_native
+PROTOTYPE: $$
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    RETVAL = THIS->lookaheadStart(include_native);
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->_lookahead_commit()
+
+int
+VPreProcXs::_lookahead_commit()
+PROTOTYPE: $
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    RETVAL = THIS->lookaheadCommit();
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->_line_map(flag)
+
+void
+VPreProcXs::_line_map(flag)
+int flag
+PROTOTYPE: $$
+CODE:
+{
+    THIS->m_lineMapWanted = flag;
+    if (!flag) THIS->lineMap(false);
+}
+
 #//**********************************************************************
 #// self->_open(filename)
 
@@ -363,3 +1075,295 @@ CODE:
 }
 OUTPUT: RETVAL
 
+
+#//**********************************************************************
+#// self->_text_source()
+
+IV
+VPreProcXs::_text_source()
+PROTOTYPE: $
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    RETVAL = PTR2IV(static_cast<VPreTextSource*>(THIS));
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->_native_defines(flag)
+
+int
+VPreProcXs::_native_defines(...)
+PROTOTYPE: $;$
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    if (items > 1) THIS->defNative(SvTRUE(ST(1)));
+    RETVAL = (THIS->m_defTablep != NULL);
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->sync_defines()
+
+void
+VPreProcXs::sync_defines()
+PROTOTYPE: $
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    THIS->defSync();
+}
+
+#//**********************************************************************
+#// self->_def_define(name, value, params, cmdline)
+
+void
+VPreProcXs::_def_define(name, value, params=&PL_sv_undef, cmdline=&PL_sv_undef)
+const char* name
+SV* value
+SV* params
+SV* cmdline
+PROTOTYPE: $$$;$$
+CODE:
+{
+    if (!THIS || !THIS->m_defTablep) XSRETURN_UNDEF;
+    string paramStr;
+    if (SvOK(params)) paramStr = SvPV_nolen(params);
+    THIS->defDefine(name, (SvOK(value) ? SvPV_nolen(value) : ""),
+		    (SvOK(params) ? &paramStr : NULL), SvTRUE(cmdline));
+}
+
+#//**********************************************************************
+#// self->_def_undef(name)
+
+void
+VPreProcXs::_def_undef(name)
+const char* name
+PROTOTYPE: $$
+CODE:
+{
+    if (!THIS || !THIS->m_defTablep) XSRETURN_UNDEF;
+    THIS->undef(name);
+}
+
+#//**********************************************************************
+#// self->_def_undefineall()
+
+void
+VPreProcXs::_def_undefineall()
+PROTOTYPE: $
+CODE:
+{
+    if (!THIS || !THIS->m_defTablep) XSRETURN_UNDEF;
+    THIS->undefineall();
+}
+
+#//**********************************************************************
+#// self->_define_templates(flag)
+
+void
+VPreProcXs::_define_templates(flag)
+int flag
+PROTOTYPE: $$
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    THIS->defineTemplates(flag);
+}
+
+#//**********************************************************************
+#// self->_def_changed(name)
+
+void
+VPreProcXs::_def_changed(name=&PL_sv_undef)
+SV* name
+PROTOTYPE: $;$
+CODE:
+{
+    // Without a name, every define may have changed
+    if (!THIS) XSRETURN_UNDEF;
+    if (SvOK(name)) THIS->defineChanged(SvPV_nolen(name));
+    else THIS->defineChangedAll();
+}
+
+#//**********************************************************************
+#// self->_include_path(dirs_ref, exts_ref)
+
+void
+VPreProcXs::_include_path(dirs, exts)
+SV* dirs
+SV* exts
+PROTOTYPE: $$$
+CODE:
+{
+    if (!THIS) XSRETURN_UNDEF;
+    vector<string> dirv, extv;
+    avStrings(dirs, dirv/*ref*/);
+    avStrings(exts, extv/*ref*/);
+    THIS->includePath(dirv, extv);
+}
+
+#//**********************************************************************
+#// self->_resolve_file(filename)
+
+SV*
+VPreProcXs::_resolve_file(filename)
+const char* filename
+PROTOTYPE: $$
+CODE:
+{
+    // Returns "" if not found
+    if (!THIS) XSRETURN_UNDEF;
+    string found = THIS->resolveFile(filename);
+    RETVAL = newSVpvn(found.data(), found.length());
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->_snapshot()
+
+SV*
+VPreProcXs::_snapshot()
+PROTOTYPE: $
+CODE:
+{
+    if (!THIS || !THIS->m_defTablep) XSRETURN_UNDEF;
+    THIS->defLoad();
+    string out = THIS->snapshot(*THIS->m_defTablep);
+    RETVAL = newSVpvn(out.data(), out.length());
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->_snapshot_restore(data)
+
+SV*
+VPreProcXs::_snapshot_restore(data)
+SV* data
+PROTOTYPE: $$
+CODE:
+{
+    // Returns "" if restored, else the reason it wasn't
+    if (!THIS || !THIS->m_defTablep) XSRETURN_UNDEF;
+    STRLEN len;
+    const char* datap = SvPV(data, len);
+    THIS->defLoad();
+    string why;
+    THIS->snapshotRestore(string(datap, len), *THIS->m_defTablep, why/*ref*/);
+    RETVAL = newSVpvn(why.data(), why.length());
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->_def_params(name)
+
+SV*
+VPreProcXs::_def_params(name)
+const char* name
+PROTOTYPE: $$
+CODE:
+{
+    if (!THIS || !THIS->m_defTablep) XSRETURN_UNDEF;
+    string ret = THIS->defParams(name);
+    RETVAL = newSVpv(ret.c_str(), ret.length());
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// self->_def_value(name)
+
+SV*
+VPreProcXs::_def_value(name)
+const char* name
+PROTOTYPE: $$
+CODE:
+{
+    if (!THIS || !THIS->m_defTablep) XSRETURN_UNDEF;
+    THIS->defLoad();
+    const VPreDefTable::Entry* entp = THIS->m_defTablep->find(name);
+    if (!entp) XSRETURN_UNDEF;
+    RETVAL = newSVpv(entp->m_value.c_str(), entp->m_value.length());
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// Verilog::Preproc::include_cache_limit(bytes)
+
+SV*
+include_cache_limit(...)
+PROTOTYPE: ;$
+CODE:
+{
+    if (items > 0) VPreProc::includeCacheLimit(SvUV(ST(0)));
+    RETVAL = newSVuv(VPreProc::includeCacheLimit());
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// Verilog::Preproc::include_cache_hash(flag)
+
+int
+include_cache_hash(...)
+PROTOTYPE: ;$
+CODE:
+{
+    if (items > 0) VPreProc::includeCacheHash(SvTRUE(ST(0)));
+    RETVAL = VPreProc::includeCacheHash();
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// Verilog::Preproc::include_cache_stats()
+
+SV*
+include_cache_stats()
+PROTOTYPE:
+CODE:
+{
+    map<string,size_t> stats;
+    VPreProc::includeCacheStats(stats/*ref*/);
+    RETVAL = statsNewRV(stats);
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// Verilog::Preproc::_prepass_rate(bytes)
+
+double
+_prepass_rate(bytes)
+size_t bytes
+PROTOTYPE: $
+CODE:
+{
+    RETVAL = VPreProc::prepassRate(bytes);
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// Verilog::Preproc::_prepass_strip(text, bytewise)
+
+SV*
+_prepass_strip(textsv, bytewise)
+SV* textsv
+bool bytewise
+PROTOTYPE: $$
+CODE:
+{
+    STRLEN textlen;
+    const char* textp = SvPV(textsv, textlen);
+    string out = VPreProc::prepassStrip(string(textp, textlen), bytewise);
+    RETVAL = newSVpvn(out.data(), out.length());
+}
+OUTPUT: RETVAL
+
+#//**********************************************************************
+#// Verilog::Preproc::include_dir_cache_flush()
+
+void
+include_dir_cache_flush()
+PROTOTYPE:
+CODE:
+{
+    VPreProc::includeDirCacheFlush();
+}
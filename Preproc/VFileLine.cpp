@@ -49,7 +49,11 @@ void VFileLine::fatal(const string& msg) {
     abort();
 }
 void VFileLine::error(const string& msg) {
+#ifdef __GNUC__
+    __sync_fetch_and_add(&VFileLine::s_numErrors, 1);  // Parsers may run on several threads
+#else
     VFileLine::s_numErrors++;
+#endif
     if (msg[msg.length()-1] != '\n') {
 	fprintf(stderr, "%%Error: %s", msg.c_str());
     } else {
@@ -57,8 +61,8 @@ void VFileLine::error(const string& msg) {
     }
 }
 
-const char* VFileLine::itoa(int i) {
-    static char buf[100];
+string VFileLine::itoa(int i) {
+    char buf[100];
     sprintf(buf,"%d",i);
     return buf;
 }
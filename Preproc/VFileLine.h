@@ -66,7 +66,7 @@ public:
     static int numErrors() { return s_numErrors; }  ///< Return total errors detected
 
     // Internal methods -- special use
-    static const char* itoa(int i);	///< Internal: Not reentrant! - for fatalSrc() only
+    static string itoa(int i);	///< Internal: for fatalSrc() only
 };
 ostream& operator<<(ostream& os, VFileLine* fileline);
 
@@ -71,31 +71,9 @@ class VPreProcImp;
 #define VP_PSL		350
 
 //======================================================================
-// Externs created by flex
-// We add a prefix so that other lexers/flexers in the same program won't collide.
-#ifndef yy_create_buffer
-# define yy_create_buffer VPreLex_create_buffer
-# define yy_delete_buffer VPreLex_delete_buffer
-# define yy_scan_buffer VPreLex_scan_buffer
-# define yy_scan_string VPreLex_scan_string
-# define yy_scan_bytes VPreLex_scan_bytes
-# define yy_flex_debug VPreLex_flex_debug
-# define yy_init_buffer VPreLex_init_buffer
-# define yy_flush_buffer VPreLex_flush_buffer
-# define yy_load_buffer_state VPreLex_load_buffer_state
-# define yy_switch_to_buffer VPreLex_switch_to_buffer
-# define yyin VPreLexin
-# define yyleng VPreLexleng
-# define yylex VPreLexlex
-# define yyout VPreLexout
-# define yyrestart VPreLexrestart
-# define yytext VPreLextext
-#endif
-
-#ifndef yyourleng
-# define yyourleng VPreLexourleng
-# define yyourtext VPreLexourtext
-#endif
+// Types created by flex
+// The lexer is reentrant, so flex's functions are only called from VPreLex.l,
+// with the scanner state each VPreLex holds.
 
 #ifndef YY_BUFFER_STATE
 struct yy_buffer_state;
@@ -103,42 +81,46 @@ typedef struct yy_buffer_state *YY_BUFFER_STATE;
 # define YY_BUF_SIZE 16384
 #endif
 
-extern int yylex();
-extern void yyrestart(FILE*);
-
-// Accessors, because flex keeps changing the type of yyleng
-extern char* yyourtext();
-extern size_t yyourleng();
-extern void yyourtext(const char* textp, size_t size);  // Must call with static
-
-YY_BUFFER_STATE yy_create_buffer(FILE *file, int size);
-void yy_switch_to_buffer(YY_BUFFER_STATE new_buffer);
-void yy_delete_buffer(YY_BUFFER_STATE b);
-
 //======================================================================
 
 #define KEEPCMT_SUB 2
 #define KEEPCMT_EXP 3
 
+//======================================================================
+// Characters for a stream that are read only as the lexer needs them
+
+class VPreStreamSource {
+public:
+    string	m_errMsg;	// Error to report when exhausted, e.g. corrupt compressed data
+    virtual ~VPreStreamSource() {}
+    /// Copy up to max_size characters into buf; return 0 only when exhausted
+    virtual size_t read(char* buf, size_t max_size) = 0;
+};
+
 //======================================================================
 // Entry for each file processed; a stack of entries included
 
 class VPreStream {
 public:
     VFileLine*		m_curFilelinep;	// Current processing point (see also m_tokFilelinep)
+    VFileLine*		m_spareFilelinep;	// Former m_curFilelinep no one refers to, for reuse
+    bool		m_curFlOwned;	// m_curFilelinep only referenced by this stream
     VPreLex*		m_lexp;		// Lexer, for resource tracking
     deque<string>	m_buffers;	// Buffer of characters to process
+    VPreStreamSource*	m_sourcep;	// Characters to process after m_buffers, or NULL
     int			m_ignNewlines;	// Ignore multiline newlines
     bool		m_eof;		// "EOF" buffer
     bool		m_file;		// Buffer is start of new file
     int			m_termState;	// Termination fsm
     VPreStream(VFileLine* fl, VPreLex* lexp)
-	: m_curFilelinep(fl), m_lexp(lexp),
+	: m_curFilelinep(fl), m_spareFilelinep(NULL), m_curFlOwned(false),
+	  m_lexp(lexp), m_sourcep(NULL),
 	  m_ignNewlines(0),
 	  m_eof(false), m_file(false), m_termState(0) {
 	lexStreamDepthAdd(1);
     }
     ~VPreStream() {
+	if (m_sourcep) { delete m_sourcep; m_sourcep = NULL; }
 	lexStreamDepthAdd(-1);
     }
 private:
@@ -153,11 +135,11 @@ class VPreLex {
     VPreProcImp*	m_preimpp;	// Preprocessor lexor belongs to
     stack<VPreStream*>	m_streampStack;	// Stack of processing files
     int			m_streamDepth;	// Depth of stream processing
+    void*		m_yyscanner;	// Flex reentrant scanner state, a yyscan_t
     YY_BUFFER_STATE	m_bufferState;	// Flex state
     VFileLine*		m_tokFilelinep;	// Starting position of current token
 
     // State to lexer
-    static VPreLex* s_currentLexp;	///< Current lexing point
     int		m_keepComments;		///< Emit comments in output text
     int		m_keepWhitespace;	///< Emit all whitespace in output text
     bool	m_pedantic;	///< Obey standard; don't Substitute `error
@@ -170,11 +152,16 @@ class VPreLex {
     bool	m_defQuote;	///< Definition value inside quote
     string	m_defValue;	///< Definition value being built.
     int		m_enterExit;	///< For VL_LINE, the enter/exit level
+    size_t	m_offSkipBytes;	///< Bytes skipped by lexOff's fast scan
+    string	m_offText;	///< Whitespace token text returned by lexOff
+    int		m_offIgnLines;	///< Newlines in lexOff's token that don't advance the line
+    string	m_rtnText;	///< Token text returned from outside flex's buffer
 
     // CONSTRUCTORS
     VPreLex(VPreProcImp* preimpp, VFileLine* filelinep) {
 	m_preimpp = preimpp;
 	m_streamDepth = 0;
+	m_yyscanner = NULL;
 	m_keepComments = 0;
 	m_keepWhitespace = 1;
 	m_pedantic = false;
@@ -185,21 +172,20 @@ class VPreLex {
 	m_defCmtSlash = false;
 	m_tokFilelinep = filelinep;
 	m_enterExit = 0;
+	m_offSkipBytes = 0;
+	m_offIgnLines = 0;
 	initFirstBuffer(filelinep);
     }
-    ~VPreLex() {
-	while (!m_streampStack.empty()) { delete m_streampStack.top(); m_streampStack.pop(); }
-	yy_delete_buffer(m_bufferState); m_bufferState=NULL;
-    }
+    ~VPreLex();
 
     /// Called by VPreLex.l from lexer
     VPreStream* curStreamp() { return m_streampStack.top(); }  // Can't be empty, "EOF" is on top
     VFileLine* curFilelinep() { return curStreamp()->m_curFilelinep; }
-    void curFilelinep(VFileLine* fl) { curStreamp()->m_curFilelinep = fl; }
+    void curFilelinep(VFileLine* fl) { curStreamp()->m_curFilelinep = fl; curStreamp()->m_curFlOwned = false; }
     void appendDefValue(const char* textp, size_t len) { m_defValue.append(textp,len); }
     void lineDirective(const char* textp) { curFilelinep(curFilelinep()->lineDirective(textp, m_enterExit/*ref*/)); }
-    void linenoInc() { if (curStreamp()->m_ignNewlines) curStreamp()->m_ignNewlines--;
-	else curFilelinep(curFilelinep()->create(curFilelinep()->lineno()+1)); }
+    void linenoInc();
+    void errorf(const char* format, ...);
     /// Called by VPreProc.cpp to inform lexer
     void pushStateDefArg(int level);
     void pushStateDefForm();
@@ -208,10 +194,16 @@ class VPreLex {
     void scanNewFile(VFileLine* filelinep);
     void scanBytes(const string& str);
     void scanBytesBack(const string& str);
+    void scanSourceBack(VPreStreamSource* sourcep);
     size_t inputToLex(char* buf, size_t max_size);
     /// Called by VPreProc.cpp to get data from lexer
     YY_BUFFER_STATE currentBuffer();
     int  lex();
+    int  lexOff();
+    // Accessors, because flex keeps changing the type of yyleng
+    char* yyourtext();
+    size_t yyourleng();
+    void yyourtext(const char* textp, size_t size);  // Must call with text that outlives the token
     int	 currentStartState();
     void dumpSummary();
     void dumpStack();
@@ -220,8 +212,8 @@ class VPreLex {
     void streamDepthAdd(int delta) { m_streamDepth += delta; }
     int streamDepth() const { return m_streamDepth; }
     /// Utility
-    static int debug();
-    static void debug(int level);
+    int debug();
+    void debug(int level);
     static string cleanDbgStrg(const string& in);
 
 private:
@@ -22,11 +22,13 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <ctime>
 #include <fstream>
 #include <cstring>
 #include <stack>
 #include <vector>
 #include <map>
+#include <set>
 #include <list>
 #include <cassert>
 #include <cerrno>
@@ -39,10 +41,46 @@
 # include <io.h>
 #else
 # include <unistd.h>
+# include <sys/time.h>
+#endif
+#if !defined(_WIN32) || defined(__CYGWIN__)
+# include <sys/mman.h>
+# include <pthread.h>
+# include <dirent.h>
+# define VPREPROC_MMAP 1
+# define VPREPROC_DIRENT 1
+# define VPREPROC_THREADS 1
+#endif
+// Sub-second part of a file's modification time, where stat has one
+#if defined(__APPLE__)
+# define VPREPROC_MTIME_NSEC(st) ((st).st_mtimespec.tv_nsec)
+#elif defined(_WIN32) && !defined(__CYGWIN__)
+# define VPREPROC_MTIME_NSEC(st) 0
+#else
+# define VPREPROC_MTIME_NSEC(st) ((st).st_mtim.tv_nsec)
+#endif
+// Vector instructions the compiler was told it may use, else plain C++
+#if defined(__AVX2__)
+# include <immintrin.h>
+# define VPREPROC_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define VPREPROC_SSE2 1
+#endif
+// Compression libraries found by Makefile.PL
+#ifdef VPREPROC_ZLIB
+# include <zlib.h>
+#endif
+#ifdef VPREPROC_ZSTD
+# include <zstd.h>
+#endif
+#ifdef VPREPROC_LZMA
+# include <lzma.h>
 #endif
 
 #include "VPreProc.h"
 #include "VPreLex.h"
+#include "VPreTextSource.h"
 
 //#undef yyFlexLexer
 //#define yyFlexLexer xxFlexLexer
@@ -71,6 +109,27 @@ public:
     ~VPreDefRef() {}
 };
 
+//*************************************************************************
+/// Compiled define value, for fast substitution
+
+class VPreDefTemplate {
+public:
+    struct Formal {
+	string	m_name;		// Argument name
+	string	m_default;	// Default value
+	bool	m_hasDefault;	// Default was specified
+    };
+    struct Segment {
+	string	m_text;		// Literal text, if m_arg<0
+	int	m_arg;		// Index of argument to substitute, or -1 for literal
+	Segment(const string& text, int arg) : m_text(text), m_arg(arg) {}
+    };
+    bool		m_valid;	// Has been compiled
+    vector<Formal>	m_formals;	// Named formal arguments, in order
+    vector<Segment>	m_segments;	// Pieces to concatenate, with arguments substituted
+    VPreDefTemplate() : m_valid(false) {}
+};
+
 //*************************************************************************
 /// Data for parsing on/off
 
@@ -86,12 +145,911 @@ public:
     ~VPreIfEntry() {}
 };
 
+//*************************************************************************
+/// Input file filtering
+
+#if defined(VPREPROC_AVX2) || defined(VPREPROC_SSE2)
+static inline char* preprocStripMasked(char* wp, const char* cp, int width, unsigned mask) {
+    // Copy the width characters at cp to wp, except those with a bit set in mask
+    int pos = 0;
+    while (mask) {
+	int i = pos;
+	while (!(mask & (1U<<i))) ++i;
+	memmove(wp, cp+pos, i-pos);
+	wp += i-pos;
+	pos = i+1;
+	mask &= mask-1;
+    }
+    memmove(wp, cp+pos, width-pos);
+    return wp + width-pos;
+}
+#endif
+
+static char* preprocStripCrNulBytes(char* wp, const char* cp, const char* endp) {
+    // Copy cp..endp to wp a character at a time, except CR and NUL; returns the new end
+    for (; cp<endp; cp++) {
+	if (!(*cp == '\r' || *cp == '\0')) {
+	    *wp++ = *cp;
+	}
+    }
+    return wp;
+}
+
+static size_t preprocStripCrNul(char* bufp, size_t len) {
+    // Filter all DOS CR's en-mass.  This avoids bugs with lexing CRs in the wrong places.
+    // This will also strip them from strings, but strings aren't supposed to be multi-line without a "\"
+    // We don't end-loop at \0 as we allow and strip mid-string '\0's (for now).
+    // Returns the new length, the buffer is edited in place.
+    // With vector instructions this is one pass: a vector without CR or NUL,
+    // the usual case, is only stored back if something before it was removed.
+    char* wp = bufp;
+    const char* cp = bufp;
+    const char* endp = bufp + len;
+#if defined(VPREPROC_AVX2)
+    const __m256i crs = _mm256_set1_epi8('\r');
+    const __m256i nuls = _mm256_setzero_si256();
+    for (; endp - cp >= 32; cp += 32) {
+	__m256i v = _mm256_loadu_si256((const __m256i*)cp);
+	unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, crs),
+									_mm256_cmpeq_epi8(v, nuls)));
+	if (!mask) {
+	    // Overlapping store only overwrites bytes already in v
+	    if (wp != cp) _mm256_storeu_si256((__m256i*)wp, v);
+	    wp += 32;
+	} else {
+	    wp = preprocStripMasked(wp, cp, 32, mask);
+	}
+    }
+#elif defined(VPREPROC_SSE2)
+    const __m128i crs = _mm_set1_epi8('\r');
+    const __m128i nuls = _mm_setzero_si128();
+    for (; endp - cp >= 16; cp += 16) {
+	__m128i v = _mm_loadu_si128((const __m128i*)cp);
+	unsigned mask = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, crs),
+								 _mm_cmpeq_epi8(v, nuls)));
+	if (!mask) {
+	    // Overlapping store only overwrites bytes already in v
+	    if (wp != cp) _mm_storeu_si128((__m128i*)wp, v);
+	    wp += 16;
+	} else {
+	    wp = preprocStripMasked(wp, cp, 16, mask);
+	}
+    }
+#else
+    if (!memchr(bufp, '\r', len) && !memchr(bufp, '\0', len)) return len;  // Usual case
+#endif
+    return preprocStripCrNulBytes(wp, cp, endp) - bufp;
+}
+
+#ifdef VPREPROC_MMAP
+class VPreMmapSource : public VPreStreamSource {
+    // A regular file mapped into memory, copied into the lexer's buffer as needed.
+    // This avoids reading the whole file into strings before lexing begins.
+    // Decompressors derive from this, with the mapping as their input.
+protected:
+    const char*	m_datap;	// Start of mapping
+    size_t	m_size;		// Size of mapping
+    size_t	m_pos;		// Next character to process
+    size_t	m_released;	// Characters before this were released to the OS
+    void releaseConsumed() {
+	// Let the OS drop pages we're done with, so resident memory stays
+	// bounded however big the file.  They'd be reread if ever touched again.
+# ifdef MADV_DONTNEED
+	static const size_t chunk = 4*1024*1024;  // Multiple of any page size
+	while (m_released + chunk <= m_pos) {
+	    madvise((void*)(m_datap + m_released), chunk, MADV_DONTNEED);
+	    m_released += chunk;
+	}
+# endif
+    }
+public:
+    VPreMmapSource(const char* datap, size_t size)
+	: m_datap(datap), m_size(size), m_pos(0), m_released(0) {}
+    virtual ~VPreMmapSource() { munmap((void*)m_datap, m_size); }
+    virtual size_t read(char* buf, size_t max_size) {
+	size_t got = 0;
+	while (!got && m_pos < m_size) {  // Loop in case all stripped
+	    size_t len = m_size - m_pos;
+	    if (len > max_size) len = max_size;
+	    memcpy(buf, m_datap + m_pos, len);
+	    m_pos += len;
+	    got = preprocStripCrNul(buf, len);
+	}
+	releaseConsumed();
+	return got;
+    }
+    static bool mapFile(const string& filename, const char*& datapr, size_t& sizer) {
+	// Map a regular, non-empty file; false if it must be read with VPreFdSource
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd<0) return false;
+	struct stat st;
+	void* mapp = MAP_FAILED;
+	if (0==fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0) {
+	    mapp = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	close(fd);  // Mapping remains valid
+	if (mapp == MAP_FAILED) return false;
+# ifdef MADV_SEQUENTIAL
+	madvise(mapp, st.st_size, MADV_SEQUENTIAL);
+# endif
+	datapr = static_cast<const char*>(mapp);
+	sizer = st.st_size;
+	return true;
+    }
+};
+
+//*************************************************************************
+/// Compressed files, decompressed in-process straight into the lexer's buffer
+
+static bool preprocMagic(const char* datap, size_t size, const char* magicp, size_t len) {
+    return size >= len && 0==memcmp(datap, magicp, len);
+}
+# define VPREPROC_MAGIC_GZIP "\x1f\x8b",2
+# define VPREPROC_MAGIC_ZSTD "\x28\xb5\x2f\xfd",4
+# define VPREPROC_MAGIC_XZ   "\xfd\x37\x7a\x58\x5a\x00",6
+
+# ifdef VPREPROC_ZLIB
+class VPreZlibSource : public VPreMmapSource {
+    z_stream	m_zs;		// Decompressor state
+    bool	m_done;		// All output returned
+public:
+    VPreZlibSource(const char* datap, size_t size)
+	: VPreMmapSource(datap, size), m_done(false) {
+	memset(&m_zs, 0, sizeof(m_zs));
+	if (inflateInit2(&m_zs, 15+16) != Z_OK) {  // 16 = gzip header
+	    m_errMsg = "gzip decompression could not initialize";
+	    m_done = true;
+	}
+    }
+    virtual ~VPreZlibSource() { inflateEnd(&m_zs); }
+    virtual size_t read(char* buf, size_t max_size) {
+	size_t got = 0;
+	while (!got && !m_done) {
+	    size_t avail = m_size - m_pos;
+	    m_zs.next_in = (Bytef*)(m_datap + m_pos);
+	    m_zs.avail_in = (uInt)(avail > (1U<<30) ? (1U<<30) : avail);
+	    m_zs.next_out = (Bytef*)buf;
+	    m_zs.avail_out = (uInt)max_size;
+	    int ret = inflate(&m_zs, Z_NO_FLUSH);
+	    m_pos = (const char*)m_zs.next_in - m_datap;
+	    got = max_size - m_zs.avail_out;
+	    if (ret == Z_STREAM_END) {
+		// gzip allows concatenated members; ignore trailing garbage like gunzip
+		if (preprocMagic(m_datap+m_pos, m_size-m_pos, VPREPROC_MAGIC_GZIP)) {
+		    inflateReset(&m_zs);
+		} else {
+		    m_done = true;
+		}
+	    } else if (ret != Z_OK) {
+		m_errMsg = (ret == Z_BUF_ERROR) ? "gzip file is truncated"
+		    : string("gzip decompression failed: ")+(m_zs.msg ? m_zs.msg : "corrupt data");
+		m_done = true;
+	    }
+	    got = preprocStripCrNul(buf, got);
+	}
+	releaseConsumed();
+	return got;
+    }
+};
+# endif
+
+# ifdef VPREPROC_ZSTD
+class VPreZstdSource : public VPreMmapSource {
+    ZSTD_DCtx*	m_dctxp;	// Decompressor state
+    size_t	m_lastRet;	// Last ZSTD_decompressStream return, 0 = frame complete
+    bool	m_done;		// All output returned
+public:
+    VPreZstdSource(const char* datap, size_t size)
+	: VPreMmapSource(datap, size), m_lastRet(0), m_done(false) {
+	m_dctxp = ZSTD_createDCtx();
+	if (!m_dctxp) {
+	    m_errMsg = "zstd decompression could not initialize";
+	    m_done = true;
+	}
+    }
+    virtual ~VPreZstdSource() { if (m_dctxp) ZSTD_freeDCtx(m_dctxp); }
+    virtual size_t read(char* buf, size_t max_size) {
+	size_t got = 0;
+	while (!got && !m_done) {
+	    ZSTD_inBuffer in = { m_datap + m_pos, m_size - m_pos, 0 };
+	    ZSTD_outBuffer out = { buf, max_size, 0 };
+	    size_t ret = ZSTD_decompressStream(m_dctxp, &out, &in);
+	    m_pos += in.pos;
+	    got = out.pos;
+	    if (ZSTD_isError(ret)) {
+		m_errMsg = string("zstd decompression failed: ")+ZSTD_getErrorName(ret);
+		m_done = true;
+	    } else if (in.pos || out.pos) {
+		m_lastRet = ret;
+	    } else {
+		// No progress; all input consumed and all output flushed
+		// Frames may be concatenated, so zero only says the last one completed
+		if (m_lastRet != 0) m_errMsg = "zstd file is truncated";
+		m_done = true;
+	    }
+	    got = preprocStripCrNul(buf, got);
+	}
+	releaseConsumed();
+	return got;
+    }
+};
+# endif
+
+# ifdef VPREPROC_LZMA
+class VPreXzSource : public VPreMmapSource {
+    lzma_stream	m_ls;		// Decompressor state
+    bool	m_done;		// All output returned
+public:
+    VPreXzSource(const char* datap, size_t size)
+	: VPreMmapSource(datap, size), m_done(false) {
+	lzma_stream init = LZMA_STREAM_INIT;
+	m_ls = init;
+	if (lzma_stream_decoder(&m_ls, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) {
+	    m_errMsg = "xz decompression could not initialize";
+	    m_done = true;
+	}
+    }
+    virtual ~VPreXzSource() { lzma_end(&m_ls); }
+    virtual size_t read(char* buf, size_t max_size) {
+	size_t got = 0;
+	while (!got && !m_done) {
+	    m_ls.next_in = (const uint8_t*)(m_datap + m_pos);
+	    m_ls.avail_in = m_size - m_pos;
+	    m_ls.next_out = (uint8_t*)buf;
+	    m_ls.avail_out = max_size;
+	    // All remaining input is always available, so can always finish
+	    lzma_ret ret = lzma_code(&m_ls, LZMA_FINISH);
+	    m_pos = (const char*)m_ls.next_in - m_datap;
+	    got = max_size - m_ls.avail_out;
+	    if (ret == LZMA_STREAM_END) {
+		m_done = true;
+	    } else if (ret != LZMA_OK) {
+		m_errMsg = (ret == LZMA_BUF_ERROR) ? "xz file is truncated" : "xz decompression failed";
+		m_done = true;
+	    }
+	    got = preprocStripCrNul(buf, got);
+	}
+	releaseConsumed();
+	return got;
+    }
+};
+# endif
+#endif
+
+//*************************************************************************
+/// Pipes and other files that can't be mapped, read as the lexer needs them
+
+class VPreFdSource : public VPreStreamSource {
+    FILE*	m_fp;		// Decompression program's pipe, or NULL
+    int		m_fd;		// File descriptor to read
+public:
+    VPreFdSource(FILE* fp, int fd) : m_fp(fp), m_fd(fd) {}
+    virtual ~VPreFdSource() {
+	if (m_fp) pclose(m_fp);
+	else ::close(m_fd);
+    }
+    virtual size_t read(char* buf, size_t max_size) {
+	size_t got = 0;
+	while (!got) {  // Loop in case all stripped
+	    errno = 0;
+	    ssize_t len = ::read(m_fd, buf, max_size);
+	    if (len>0) {
+		got = preprocStripCrNul(buf, len);
+	    }
+	    else if (errno == EINTR || errno == EAGAIN
+#ifdef EWOULDBLOCK
+		     || errno == EWOULDBLOCK
+#endif
+		) {
+	    } else break;  // EOF
+	}
+	return got;
+    }
+    static VPreFdSource* openFile(const string& filename, const string& filtercmd) {
+	// Return source, or NULL if the file can't be opened
+	if (filtercmd != "") {
+	    string cmd = filtercmd+" "+filename;
+	    FILE* fp = popen(cmd.c_str(), "r");
+	    if (!fp) return NULL;
+	    return new VPreFdSource(fp, fileno(fp));
+	} else {
+	    int fd = ::open(filename.c_str(), O_RDONLY);
+	    if (fd<0) return NULL;
+	    return new VPreFdSource(NULL, fd);
+	}
+    }
+};
+
+static VPreStreamSource* preprocOpenSource(const string& filename, string& filtercmdr) {
+    // Return a source to read the file in-process, else NULL to use VPreFdSource,
+    // with filtercmdr set to the decompression command, if any.
+    // Compression is determined by the magic number, not filename.
+    filtercmdr = "";
+#ifdef VPREPROC_MMAP
+    const char* datap;
+    size_t size;
+    if (VPreMmapSource::mapFile(filename, datap/*ref*/, size/*ref*/)) {
+	if (preprocMagic(datap, size, VPREPROC_MAGIC_GZIP)) {
+# ifdef VPREPROC_ZLIB
+	    return new VPreZlibSource(datap, size);
+# else
+	    filtercmdr = "gunzip -c";
+# endif
+	} else if (preprocMagic(datap, size, VPREPROC_MAGIC_ZSTD)) {
+# ifdef VPREPROC_ZSTD
+	    return new VPreZstdSource(datap, size);
+# else
+	    filtercmdr = "zstd -dc";
+# endif
+	} else if (preprocMagic(datap, size, VPREPROC_MAGIC_XZ)) {
+# ifdef VPREPROC_LZMA
+	    return new VPreXzSource(datap, size);
+# else
+	    filtercmdr = "xz -dc";
+# endif
+	} else {
+	    return new VPreMmapSource(datap, size);
+	}
+	munmap((void*)datap, size);
+	return NULL;
+    }
+#endif
+    // Can't look at contents of pipes, etc, so fall back to the extension
+    if (filename.length()>3 && 0==filename.compare(filename.length()-3, 3, ".gz")) {
+	filtercmdr = "gunzip -c";
+    }
+    return NULL;
+}
+
+//*************************************************************************
+/// Lock for the process-wide tables below, as preprocessors may run on
+/// several threads at once
+
+class VPreMutex {
+#ifdef VPREPROC_THREADS
+    pthread_mutex_t	m_mutex;
+public:
+    VPreMutex() { pthread_mutex_init(&m_mutex, NULL); }
+    ~VPreMutex() { pthread_mutex_destroy(&m_mutex); }
+    void lock() { pthread_mutex_lock(&m_mutex); }
+    void unlock() { pthread_mutex_unlock(&m_mutex); }
+#else
+public:
+    void lock() {}
+    void unlock() {}
+#endif
+};
+
+class VPreMutexLock {
+    // Held until end of scope
+    VPreMutex&	m_mutex;
+public:
+    explicit VPreMutexLock(VPreMutex& mutex) : m_mutex(mutex) { m_mutex.lock(); }
+    ~VPreMutexLock() { m_mutex.unlock(); }
+};
+
+//*************************************************************************
+/// Process-wide cache of directory listings, for VPreProc::resolveFile
+/// Statting every include directory and extension is slow on network
+/// filesystems; instead list each directory once, then stat only a match.
+
+class VPreDirCache {
+    typedef set<string> Names;
+    typedef map<string,Names> DirMap;
+    DirMap	m_dirs;		// Entries in each directory listed
+    VPreMutex	m_mutex;	// Protects m_dirs
+public:
+    static VPreDirCache& singleton() {
+	static VPreDirCache s_cache;
+	return s_cache;
+    }
+    void clear() { VPreMutexLock lock(m_mutex); m_dirs.clear(); }
+    static bool readableFile(const string& filename) {
+	// Same as Perl's -r && !-d
+	struct ::stat st;
+	if (0!=::stat(filename.c_str(), &st) || S_ISDIR(st.st_mode)) return false;
+	return 0==access(filename.c_str(), R_OK);
+    }
+    bool exists(const string& path) {
+	// Return true if path may be a readable file
+#ifdef VPREPROC_DIRENT
+	string::size_type slash = path.rfind('/');
+	string dir = (slash == string::npos) ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+	string name = (slash == string::npos) ? path : path.substr(slash+1);
+	if (!listed(dir, name)) return false;
+#endif
+	return readableFile(path);
+    }
+private:
+#ifdef VPREPROC_DIRENT
+    bool listed(const string& dir, const string& name) {
+	// Return true if dir's listing has name, listing dir if not yet seen
+	VPreMutexLock lock(m_mutex);
+	DirMap::iterator it = m_dirs.find(dir);
+	if (it == m_dirs.end()) {
+	    it = m_dirs.insert(make_pair(dir, Names())).first;
+	    if (DIR* dirp = opendir(dir.c_str())) {
+		while (struct dirent* entp = readdir(dirp)) {
+		    it->second.insert(entp->d_name);
+		}
+		closedir(dirp);
+	    }
+	}
+	return it->second.find(name) != it->second.end();
+    }
+#endif
+};
+
+//*************************************************************************
+/// Encoding for VPreProc::snapshot
+
+class VPreSnapWriter {
+    string&	m_out;
+public:
+    explicit VPreSnapWriter(string& out) : m_out(out) {}
+    void num(unsigned long val) {
+	// Seven bits per byte, high bit set if more follow
+	while (val >= 0x80) { m_out += (char)((val & 0x7f) | 0x80); val >>= 7; }
+	m_out += (char)val;
+    }
+    void str(const string& val) { num(val.length()); m_out += val; }
+};
+
+class VPreSnapReader {
+    const string& m_data;
+    size_t	m_pos;
+    bool	m_ok;	// Not truncated
+public:
+    VPreSnapReader(const string& data, size_t pos) : m_data(data), m_pos(pos), m_ok(true) {}
+    bool ok() const { return m_ok; }
+    unsigned long num() {
+	unsigned long val = 0;
+	for (size_t shift = 0; m_ok; shift += 7) {
+	    if (m_pos >= m_data.length() || shift >= sizeof(val)*8) { m_ok = false; break; }
+	    unsigned char c = m_data[m_pos++];
+	    val |= (unsigned long)(c & 0x7f) << shift;
+	    if (!(c & 0x80)) return val;
+	}
+	return 0;
+    }
+    string str() {
+	unsigned long len = num();
+	if (!m_ok || len > m_data.length() - m_pos) { m_ok = false; return ""; }
+	string val(m_data, m_pos, len);
+	m_pos += len;
+	return val;
+    }
+};
+
+//*************************************************************************
+/// Identity of a file on disk; if any part changes the file must be re-read
+
+class VPreFileIdent {
+    dev_t	m_dev;
+    ino_t	m_ino;
+    off_t	m_size;
+    time_t	m_mtime;
+    long	m_mtimeNsec;	// As files may change more than once a second
+public:
+    VPreFileIdent() : m_dev(0), m_ino(0), m_size(0), m_mtime(0), m_mtimeNsec(0) {}
+    bool stat(const string& filename) {
+	// Return false if not a regular file
+	struct ::stat st;
+	if (0!=::stat(filename.c_str(), &st) || !S_ISREG(st.st_mode)) return false;
+	m_dev = st.st_dev;
+	m_ino = st.st_ino;
+	m_size = st.st_size;
+	m_mtime = st.st_mtime;
+	m_mtimeNsec = VPREPROC_MTIME_NSEC(st);
+	return true;
+    }
+    size_t size() const { return m_size; }
+    void snapWrite(VPreSnapWriter& w) const {
+	w.num(m_dev); w.num(m_ino); w.num(m_size); w.num(m_mtime); w.num(m_mtimeNsec);
+    }
+    void snapRead(VPreSnapReader& r) {
+	m_dev = r.num(); m_ino = r.num(); m_size = r.num(); m_mtime = r.num(); m_mtimeNsec = r.num();
+    }
+    bool operator==(const VPreFileIdent& rhs) const {
+	return m_dev==rhs.m_dev && m_ino==rhs.m_ino
+	    && m_size==rhs.m_size && m_mtime==rhs.m_mtime && m_mtimeNsec==rhs.m_mtimeNsec;
+    }
+};
+
+//*************************************************************************
+/// Process-wide cache of included file contents, shared by all VPreProc's
+
+class VPreFileCache {
+public:
+    typedef VPreFileIdent Ident;
+    class Entry {
+    public:
+	string		m_text;		// Contents, decompressed and with CRs stripped
+	size_t		m_hash;		// Hash of m_text, if content hashing
+	unsigned	m_refs;		// References from sources, plus one while cached
+	vector<string>	m_paths;	// Filenames with these contents, while cached
+	list<Entry*>::iterator m_lruIt;	// Position in m_lru, while cached
+	Entry() : m_hash(0), m_refs(0) {}
+    };
+private:
+    typedef map<string, pair<Ident,Entry*> > PathMap;
+    typedef multimap<size_t, Entry*> HashMap;
+
+    PathMap	m_paths;	// Entry for each filename
+    HashMap	m_hashes;	// Entry for each content hash
+    list<Entry*> m_lru;		// Cached entries, most recently used first
+    size_t	m_limit;	// Maximum bytes to cache, 0=disabled
+    bool	m_contentHash;	// Share entries with identical contents
+    size_t	m_bytes;	// Bytes cached
+    size_t	m_hits;		// Opens satisfied from cache
+    size_t	m_misses;	// Opens read from disk
+    size_t	m_bytesSaved;	// Bytes not read from disk due to hits
+    size_t	m_evictions;	// Entries removed to stay under m_limit
+    mutable VPreMutex m_mutex;	// Protects all above, and each Entry's m_refs
+
+    VPreFileCache()
+	: m_limit(64*1024*1024), m_contentHash(false), m_bytes(0),
+	  m_hits(0), m_misses(0), m_bytesSaved(0), m_evictions(0) {}
+    ~VPreFileCache() { evict(0); }
+    static size_t hashText(const string& text) {
+	// FNV-1a
+	size_t hash = (size_t)14695981039346656037ULL;
+	for (const char* cp=text.data(); cp<text.data()+text.length(); cp++) {
+	    hash = (hash ^ (unsigned char)(*cp)) * (size_t)1099511628211ULL;
+	}
+	return hash;
+    }
+    void evict(size_t limit) {
+	// Remove least recently used entries until no more than limit bytes remain
+	while (m_bytes > limit && !m_lru.empty()) {
+	    if (limit) m_evictions++;
+	    remove(m_lru.back());
+	}
+    }
+    void remove(Entry* entp) {
+	for (vector<string>::iterator it=entp->m_paths.begin(); it!=entp->m_paths.end(); ++it) {
+	    m_paths.erase(*it);
+	}
+	entp->m_paths.clear();
+	pair<HashMap::iterator,HashMap::iterator> range = m_hashes.equal_range(entp->m_hash);
+	for (HashMap::iterator it=range.first; it!=range.second; ++it) {
+	    if (it->second == entp) { m_hashes.erase(it); break; }
+	}
+	m_lru.erase(entp->m_lruIt);
+	m_bytes -= entp->m_text.length();
+	unref(entp);
+    }
+    void unref(Entry* entp) {
+	if (--entp->m_refs == 0) delete entp;
+    }
+    void forget(const string& filename) {
+	// File changed on disk
+	PathMap::iterator it = m_paths.find(filename);
+	if (it == m_paths.end()) return;
+	Entry* entp = it->second.second;
+	m_paths.erase(it);
+	for (vector<string>::iterator pit=entp->m_paths.begin(); pit!=entp->m_paths.end(); ++pit) {
+	    if (*pit == filename) { entp->m_paths.erase(pit); break; }
+	}
+	if (entp->m_paths.empty()) remove(entp);
+    }
+    void touch(Entry* entp) {
+	m_lru.erase(entp->m_lruIt);
+	m_lru.push_front(entp);
+	entp->m_lruIt = m_lru.begin();
+    }
+public:
+    static VPreFileCache& singleton() {
+	static VPreFileCache s_cache;
+	return s_cache;
+    }
+    // ACCESSORS
+    size_t limit() const { VPreMutexLock lock(m_mutex); return m_limit; }
+    void limit(size_t bytes) { VPreMutexLock lock(m_mutex); m_limit = bytes; evict(m_limit); }
+    bool contentHash() const { VPreMutexLock lock(m_mutex); return m_contentHash; }
+    void contentHash(bool flag) {
+	VPreMutexLock lock(m_mutex);
+	m_contentHash = flag;
+	if (!flag) m_hashes.clear();
+    }
+    void stats(map<string,size_t>& statsr) const {
+	VPreMutexLock lock(m_mutex);
+	statsr["hits"] = m_hits;
+	statsr["misses"] = m_misses;
+	statsr["bytes_saved"] = m_bytesSaved;
+	statsr["evictions"] = m_evictions;
+	statsr["bytes"] = m_bytes;
+	statsr["entries"] = m_lru.size();
+	statsr["limit"] = m_limit;
+    }
+    // METHODS
+    Entry* lookup(const string& filename, const Ident& ident) {
+	// Return referenced entry, or NULL if not cached
+	VPreMutexLock lock(m_mutex);
+	PathMap::iterator it = m_paths.find(filename);
+	if (it == m_paths.end()) return NULL;
+	if (!(it->second.first == ident)) { forget(filename); return NULL; }
+	Entry* entp = it->second.second;
+	touch(entp);
+	m_hits++;
+	m_bytesSaved += entp->m_text.length();
+	entp->m_refs++;
+	return entp;
+    }
+    Entry* insert(const string& filename, const Ident& ident, string& textr) {
+	// Take text, cache it if it fits, and return referenced entry
+	VPreMutexLock lock(m_mutex);
+	forget(filename);  // Another thread may have read it at the same time
+	m_misses++;
+	if (m_contentHash) {
+	    size_t hash = hashText(textr);
+	    pair<HashMap::iterator,HashMap::iterator> range = m_hashes.equal_range(hash);
+	    for (HashMap::iterator it=range.first; it!=range.second; ++it) {
+		Entry* entp = it->second;
+		if (entp->m_text == textr) {
+		    m_paths[filename] = make_pair(ident, entp);
+		    entp->m_paths.push_back(filename);
+		    touch(entp);
+		    entp->m_refs++;
+		    return entp;
+		}
+	    }
+	    Entry* entp = insertNew(filename, ident, textr);
+	    if (entp->m_refs > 1) {
+		entp->m_hash = hash;
+		m_hashes.insert(make_pair(hash, entp));
+	    }
+	    return entp;
+	}
+	return insertNew(filename, ident, textr);
+    }
+    void release(Entry* entp) {
+	VPreMutexLock lock(m_mutex);
+	unref(entp);
+    }
+private:
+    Entry* insertNew(const string& filename, const Ident& ident, string& textr) {
+	Entry* entp = new Entry;
+	entp->m_text.swap(textr);
+	entp->m_refs = 1;  // Caller's
+	// Don't let one big file flush everything else
+	if (entp->m_text.length() <= m_limit/4) {
+	    entp->m_refs++;
+	    entp->m_paths.push_back(filename);
+	    m_paths[filename] = make_pair(ident, entp);
+	    m_lru.push_front(entp);
+	    entp->m_lruIt = m_lru.begin();
+	    m_bytes += entp->m_text.length();
+	    evict(m_limit);
+	}
+	return entp;
+    }
+};
+
+class VPreFileCacheSource : public VPreStreamSource {
+    // Contents of a cached file, already filtered
+    VPreFileCache::Entry* m_entp;	// Referenced entry
+    size_t	m_pos;		// Next character to return
+public:
+    VPreFileCacheSource(VPreFileCache::Entry* entp) : m_entp(entp), m_pos(0) {}
+    virtual ~VPreFileCacheSource() { VPreFileCache::singleton().release(m_entp); }
+    virtual size_t read(char* buf, size_t max_size) {
+	size_t len = m_entp->m_text.length() - m_pos;
+	if (len > max_size) len = max_size;
+	memcpy(buf, m_entp->m_text.data() + m_pos, len);
+	m_pos += len;
+	return len;
+    }
+};
+
+static VPreStreamSource* preprocOpenCachedSource(const string& filename, const VPreFileIdent& ident) {
+    // Return a source from the include cache, else NULL to open normally
+    VPreFileCache& cache = VPreFileCache::singleton();
+    if (!cache.limit()) return NULL;
+    if (VPreFileCache::Entry* entp = cache.lookup(filename, ident)) {
+	return new VPreFileCacheSource(entp);
+    }
+    if (ident.size() > cache.limit()/4) return NULL;  // Too big; don't bother reading it
+    string filtercmd;
+    VPreStreamSource* sourcep = preprocOpenSource(filename, filtercmd/*ref*/);
+    if (!sourcep) return NULL;  // Needs a decompression program
+    // Read it all, straight into the string that will be cached
+    string text;
+    size_t got = 0;
+    text.resize(ident.size() + 1);
+    while (1) {
+	if (got == text.length()) text.resize(text.length()*2);
+	size_t len = sourcep->read(&text[got], text.length()-got);
+	if (!len) break;
+	got += len;
+    }
+    text.resize(got);
+    bool ok = (sourcep->m_errMsg == "");
+    delete sourcep;
+    if (!ok) return NULL;  // Reopen to report the error
+    return new VPreFileCacheSource(cache.insert(filename, ident, text/*ref*/));
+}
+
+//*************************************************************************
+/// Include guards, learned from files entirely within a `ifndef
+
+class VPreGuardDetect {
+public:
+    // One for each file being read
+    enum GuardState { gs_START, gs_NAME, gs_INSIDE, gs_ENDED, gs_FAIL };
+    VPreStream*	m_streamp;	// Stream reading the file
+    string	m_filename;	// Filename as opened
+    VPreFileIdent m_ident;	// File identity
+    size_t	m_ifdefDepth;	// Depth of ifdef stack outside the guard
+    GuardState	m_state;	// Detection state
+    string	m_guard;	// Define name from the `ifndef
+    bool	m_cmtOutside;	// Comments outside the guard
+    VPreGuardDetect(VPreStream* streamp, const string& filename,
+		    const VPreFileIdent& ident, size_t ifdefDepth)
+	: m_streamp(streamp), m_filename(filename), m_ident(ident),
+	  m_ifdefDepth(ifdefDepth), m_state(gs_START), m_cmtOutside(false) {}
+};
+
+class VPreGuardTable {
+    // Process-wide, as the defines are checked by each VPreProc before skipping
+public:
+    struct Guard {
+	VPreFileIdent	m_ident;	// File identity when learned
+	string		m_guard;	// Define name
+	bool		m_cmtOutside;	// Comments outside the guard, so can't skip if keeping comments
+    };
+private:
+    typedef map<string,Guard> GuardMap;
+    GuardMap	m_guards;	// Guard for each filename
+    VPreMutex	m_mutex;	// Protects m_guards
+public:
+    static VPreGuardTable& singleton() {
+	static VPreGuardTable s_table;
+	return s_table;
+    }
+    void learn(const VPreGuardDetect& det) {
+	learn(det.m_filename, det.m_ident, det.m_guard, det.m_cmtOutside);
+    }
+    void learn(const string& filename, const VPreFileIdent& ident, const string& guardName, bool cmtOutside) {
+	VPreMutexLock lock(m_mutex);
+	Guard& guard = m_guards[filename];
+	guard.m_ident = ident;
+	guard.m_guard = guardName;
+	guard.m_cmtOutside = cmtOutside;
+    }
+    bool lookup(const string& filename, const VPreFileIdent& ident, Guard& guardr) {
+	VPreMutexLock lock(m_mutex);
+	GuardMap::const_iterator it = m_guards.find(filename);
+	if (it == m_guards.end() || !(it->second.m_ident == ident)) return false;
+	guardr = it->second;
+	return true;
+    }
+    void forget(const string& filename) { VPreMutexLock lock(m_mutex); m_guards.erase(filename); }
+    bool find(const string& filename, const VPreFileIdent& ident, bool keepComments, string& guardr) {
+	VPreMutexLock lock(m_mutex);
+	GuardMap::iterator it = m_guards.find(filename);
+	if (it == m_guards.end()) return false;
+	if (!(it->second.m_ident == ident)) { m_guards.erase(it); return false; }
+	if (keepComments && it->second.m_cmtOutside) return false;
+	guardr = it->second.m_guard;
+	return true;
+    }
+};
+
+//*************************************************************************
+/// Preprocessing on a separate thread, for VPreProc::pipelineStart
+
+class VPreProcImp;
+
+class VPrePipeline {
+    enum MiscConsts {
+	CHUNK_SIZE = 64*1024,		// Bytes produced per queue entry
+	QUEUE_LIMIT = 16*CHUNK_SIZE	// Bytes queued before producer waits
+    };
+    VPreProcImp*	m_implp;	// Preprocessor being run
+    deque<string>	m_queue;	// Text produced, not yet read
+    size_t		m_queueBytes;	// Total length of m_queue
+    VPreProc::PipelineCall* m_callp;	// Call waiting for consumer after m_queue, or NULL
+    bool		m_callDone;	// m_callp has been run
+    bool		m_eof;		// Producer finished
+    bool		m_abort;	// Producer must stop
+    bool		m_aborted;	// A call set m_abort
+    bool		m_started;	// Producer thread was created
+    string		m_text;		// Consumer's entry from m_queue
+    size_t		m_textPos;	// Consumer's position in m_text
+#ifdef VPREPROC_THREADS
+    pthread_t		m_thread;	// Producer
+    pthread_t		m_consumer;	// Thread that created the pipeline, see isProducer
+    pthread_mutex_t	m_mutex;	// Protects all above except m_text
+    pthread_cond_t	m_cond;		// Signals any change
+    pthread_mutex_t	m_runMutex;	// Held by producer while preprocessing, see pause()
+#endif
+public:
+    explicit VPrePipeline(VPreProcImp* implp);
+    ~VPrePipeline();
+    bool start();
+    bool isProducer() const;
+    bool aborted() const { return m_aborted; }
+    size_t getText(char* bufp, size_t max_size);
+    void call(VPreProc::PipelineCall& call);
+    void stop();
+    void pause();
+    void resume();
+private:
+    void produce();
+    static void* threadMain(void* pipelinep);
+    void lock();
+    void unlock();
+    void wait();
+    void signal();
+};
+
+//*************************************************************************
+/// Location of a `line given to the line map.  The stream carries
+/// VPRE_LINE_MARK in the directive's place, so the text need not be
+/// built and parsed back.
+
+struct VPreLineLoc {
+    string	m_filename;
+    int		m_lineno;
+    int		m_enterExit;
+};
+static const char* const VPRE_LINE_MARK = "`line *\n";
+
+//*************************************************************************
+/// Location of each output line that doesn't follow from the line before,
+/// see VPreProc::lineMap.  Marks are added by whichever thread preprocesses
+/// and read by the consumer.
+
+class VPreLineMap {
+    deque<VPreLineMark>	m_marks;	// Marks not yet passed by the consumer
+#ifdef VPREPROC_THREADS
+    pthread_mutex_t	m_mutex;	// Protects m_marks
+    void lock() { pthread_mutex_lock(&m_mutex); }
+    void unlock() { pthread_mutex_unlock(&m_mutex); }
+#else
+    void lock() {}
+    void unlock() {}
+#endif
+public:
+    size_t	m_outLines;	// Newlines in the output so far, used only by the producer
+    bool	m_outAtBol;	// Output so far ends in a newline, used only by the producer
+    VPreLineMap() : m_outLines(0), m_outAtBol(true) {
+#ifdef VPREPROC_THREADS
+	pthread_mutex_init(&m_mutex, NULL);
+#endif
+    }
+    ~VPreLineMap() {
+#ifdef VPREPROC_THREADS
+	pthread_mutex_destroy(&m_mutex);
+#endif
+    }
+    void add(const string& filename, int lineno) {
+	// Location of the next output line; a later mark for the same line replaces it
+	VPreLineMark mark;
+	mark.m_outLine = m_outLines;
+	mark.m_filename = filename;
+	mark.m_lineno = lineno;
+	lock();
+	if (!m_marks.empty() && m_marks.back().m_outLine == mark.m_outLine) m_marks.back() = mark;
+	else m_marks.push_back(mark);
+	unlock();
+    }
+    bool next(size_t fromLine, VPreLineMark& markr) {
+	lock();
+	while (!m_marks.empty() && m_marks.front().m_outLine < fromLine) m_marks.pop_front();
+	bool found = !m_marks.empty();
+	if (found) markr = m_marks.front();
+	unlock();
+	return found;
+    }
+};
+
 //*************************************************************************
 /// Data for a preprocessor instantiation.
 
 class VPreProcImp : public VPreProcOpaque {
 public:
-    typedef list<string> StrList;
 
     VPreProc*	m_preprocp;	///< Object we're holding data for
     int		m_debug;	///< Debugging level
@@ -122,19 +1080,27 @@ public:
     bool	m_lineCmtNl;	///< Newline needed before inserting lineCmt
     int		m_lineAdd;	///< Empty lines to return to maintain line count
     bool	m_rawAtBol;	///< Last rawToken left us at beginning of line
+    bool	m_rawOffWhite;	///< Last rawToken is whitespace lexOff gathered from disabled text
+    deque<VPreLineLoc> m_lineLocs;	///< Locations of each VPRE_LINE_MARK not yet returned
 
     // For getFinalToken
     bool	m_finAhead;	///< Have read a token ahead
     int		m_finToken;	///< Last token read
-    string	m_finBuf;	///< Last yytext read
+    string	m_finBuf;	///< Last yytext read, or the rest of it not yet returned
+    bool	m_finNextLine;	///< m_finBuf is the rest of lexOff's token, from the next line
+    bool	m_finLineRest;	///< m_finBuf is what follows a `line split from it
     bool	m_finAtBol;	///< Last getFinalToken left us at beginning of line
     VFileLine*	m_finFilelinep;	///< Location of last returned token (internal only)
+    bool	m_finLine;	///< Last getFinalToken returned a `line directive
+    VPreLineMap* m_lineMapp;	///< Locations given in place of `line, or NULL
 
     // For stringification
     string	m_strify;	///< Text to be stringified
 
     // For defines
     stack<VPreDefRef> m_defRefs; // Pending definine substitution
+    map<string,VPreDefTemplate> m_defTemplates;	///< Compiled define values, by name
+    bool	m_defTemplatesOn;	///< Keep m_defTemplates; the define callbacks report changes
     stack<VPreIfEntry> m_ifdefStack;	///< Stack of true/false emitting evaluations
     unsigned	m_defDepth;	///< How many `defines deep
     bool	m_defPutJoin;	///< Insert `` after substitution
@@ -143,25 +1109,53 @@ public:
     stack<string> m_joinStack;	///< Text on lhs of join
 
     // For getline()
-    string	m_lineChars;	///< Characters left for next line
+    string	m_lineChars;	///< Characters left for next line, starting at m_lineStart
+    size_t	m_lineStart;	///< Offset in m_lineChars of first unreturned character
+    size_t	m_lineScanned;	///< Offset in m_lineChars before which there is no newline
+
+    // For include guards
+    vector<VPreGuardDetect> m_guardDetects;	///< Guard detection for each file being read
+
+    // For stats()
+    size_t	m_statGuardSkips;	///< Includes skipped due to include guards
+    VPreProfile* m_profilep;	///< Cost accounting, or NULL if not profiling
+    VPreDefUse* m_defUsep;	///< Define use recording, or NULL if not recording
+    map<string,VPreFileIdent> m_depFiles;	///< Regular files opened, for snapshot
+    vector<string> m_incDirs;	///< Directories for resolveFile, without duplicates
+    vector<string> m_incExts;	///< Extensions for resolveFile, including ""
+    VPrePipeline* m_pipelinep;	///< Thread doing preprocessing, or NULL
+    bool	m_pipelineAborted;	///< Last pipeline ended by a PipelineCall's m_abort
 
     VPreProcImp() {
 	m_debug = 0;
 	m_states.push(ps_TOP);
 	m_off = 0;
 	m_lineChars = "";
+	m_lineStart = 0;
+	m_lineScanned = 0;
 	m_lastSym = "";
 	m_lineAdd = 0;
 	m_lineCmtNl = false;
 	m_rawAtBol = true;
+	m_rawOffWhite = false;
 	m_finAhead = false;
+	m_finNextLine = false;
+	m_finLineRest = false;
 	m_finAtBol = true;
+	m_finLine = false;
+	m_lineMapp = NULL;
 	m_defDepth = 0;
 	m_defPutJoin = false;
+	m_defTemplatesOn = true;
 	m_finToken = 0;
 	m_finFilelinep = NULL;
 	m_lexp = NULL;
 	m_preprocp = NULL;
+	m_statGuardSkips = 0;
+	m_profilep = NULL;
+	m_defUsep = NULL;
+	m_pipelinep = NULL;
+	m_pipelineAborted = false;
     }
     void configure(VFileLine* filelinep, VPreProc* preprocp) {
 	// configure() separate from constructor to avoid calling abstract functions
@@ -176,25 +1170,43 @@ public:
 	m_lexp->debug(debug()>=10 ? debug() : 0);  // See also VPreProc::debug() method
     }
     ~VPreProcImp() {
+	if (m_pipelinep) { delete m_pipelinep; m_pipelinep = NULL; }
 	if (m_lexp) { delete m_lexp; m_lexp = NULL; }
+	if (m_profilep) { delete m_profilep; m_profilep = NULL; }
+	if (m_defUsep) { delete m_defUsep; m_defUsep = NULL; }
+	if (m_lineMapp) { delete m_lineMapp; m_lineMapp = NULL; }
     }
     const char* tokenName(int tok);
     void debugToken(int tok, const char* cmtp);
     void parseTop();
     void parseUndef();
     string getparseline(bool stop_at_eol, size_t approx_chunk);
+    template <bool Profile> size_t getparseLength(bool stop_at_eol, size_t approx_chunk);
+    size_t getparseLength(bool stop_at_eol, size_t approx_chunk) {
+	// Profiling is a separate instance of the token loop, so costs nothing when off
+	return m_profilep ? getparseLength<true>(stop_at_eol, approx_chunk)
+	    : getparseLength<false>(stop_at_eol, approx_chunk);
+    }
+    size_t getText(char* bufp, size_t max_size);
+    const char* lineCharsNewline();
+    void lineCharsConsume(size_t len);
+    void lineCharsAppend(const string& text);
+    void lineMapMark(const string& text);
+    bool lineCharsPending() const { return m_lineStart < m_lineChars.length(); }
     bool isEof() const { return m_lexp->curStreamp()->m_eof; }
-    bool readWholefile(const string& filename, StrList& outl);
     void openFile(string filename, VFileLine* filelinep);
     void insertUnreadback(const string& text) { m_lineCmt += text; }
     void insertUnreadbackAtBol(const string& text);
     void addLineComment(int enter_exit_level);
+    void stats(map<string,size_t>& statsr);
 private:
     void error(string msg) { m_lexp->m_tokFilelinep->error(msg); }
     void fatal(string msg) { m_lexp->m_tokFilelinep->fatal(msg); }
     int debug() const { return m_debug; }
     void endOfOneFile();
+    void guardToken(int tok);
     string defineSubst(VPreDefRef* refp);
+    void defineCompile(VPreDefTemplate& tmpl, const string& params, const string& value);
     string trimWhitespace(const string& strg, bool trailing);
     void unputString(const string& strg);
     void unputDefrefString(const string& strg);
@@ -206,9 +1218,9 @@ private:
     }
     void parsingOff() { m_off++; }
 
-    int getRawToken();
-    int getStateToken(string& buf);
-    int getFinalToken(string& buf);
+    template <bool Profile> int getRawToken();
+    template <bool Profile> int getStateToken(string& buf);
+    template <bool Profile> int getFinalToken(string& buf);
 
     ProcState state() const { return m_states.top(); }
     bool stateIsDefname() const {
@@ -235,7 +1247,163 @@ private:
 };
 
 //*************************************************************************
-// Creation
+// VPrePipeline Methods
+
+VPrePipeline::VPrePipeline(VPreProcImp* implp)
+    : m_implp(implp), m_queueBytes(0), m_callp(NULL), m_callDone(false),
+      m_eof(false), m_abort(false), m_aborted(false), m_started(false), m_textPos(0) {
+#ifdef VPREPROC_THREADS
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_cond, NULL);
+    pthread_mutex_init(&m_runMutex, NULL);
+    // Set before the producer exists, so it is seen by both threads, unlike
+    // m_thread which the producer may start running before it is set
+    m_consumer = pthread_self();
+#endif
+}
+
+VPrePipeline::~VPrePipeline() {
+    stop();
+#ifdef VPREPROC_THREADS
+    pthread_mutex_destroy(&m_runMutex);
+    pthread_cond_destroy(&m_cond);
+    pthread_mutex_destroy(&m_mutex);
+#endif
+}
+
+#ifdef VPREPROC_THREADS
+void VPrePipeline::lock() { pthread_mutex_lock(&m_mutex); }
+void VPrePipeline::unlock() { pthread_mutex_unlock(&m_mutex); }
+void VPrePipeline::wait() { pthread_cond_wait(&m_cond, &m_mutex); }
+void VPrePipeline::signal() { pthread_cond_broadcast(&m_cond); }
+void VPrePipeline::pause() { pthread_mutex_lock(&m_runMutex); }
+void VPrePipeline::resume() { pthread_mutex_unlock(&m_runMutex); }
+#else
+void VPrePipeline::lock() {}
+void VPrePipeline::unlock() {}
+void VPrePipeline::wait() {}
+void VPrePipeline::signal() {}
+void VPrePipeline::pause() {}
+void VPrePipeline::resume() {}
+#endif
+
+bool VPrePipeline::start() {
+#ifdef VPREPROC_THREADS
+    m_started = (0 == pthread_create(&m_thread, NULL, &VPrePipeline::threadMain, this));
+#endif
+    return m_started;
+}
+
+void VPrePipeline::stop() {
+    // Make producer finish, if it hasn't already
+    if (!m_started) return;
+#ifdef VPREPROC_THREADS
+    lock();
+    m_abort = true;
+    signal();
+    unlock();
+    pthread_join(m_thread, NULL);
+#endif
+    m_started = false;
+}
+
+void VPrePipeline::produce() {
+    // Producer: preprocess into the queue, waiting when it's full
+    VPreProfile* profp = m_implp->m_profilep;
+    if (profp) profp->resume();
+    string buf(CHUNK_SIZE, '\0');
+    try {
+	while (1) {
+	    // The consumer's pause() waits for the chunk to finish
+	    pause();
+	    size_t len = m_implp->getText(&buf[0], CHUNK_SIZE);
+	    resume();
+	    lock();
+	    while (m_queueBytes >= QUEUE_LIMIT && !m_abort) wait();
+	    if (m_abort || !len) {
+		m_eof = true;
+		signal();
+		unlock();
+		break;
+	    }
+	    m_queue.push_back(string(buf.data(), len));
+	    m_queueBytes += len;
+	    signal();
+	    unlock();
+	}
+    } catch (VPreProc::PipelineAbort&) {
+	resume();
+	lock();
+	m_eof = true;
+	signal();
+	unlock();
+    }
+    if (profp) profp->pause();
+}
+
+bool VPrePipeline::isProducer() const {
+#ifdef VPREPROC_THREADS
+    return !pthread_equal(pthread_self(), m_consumer);
+#else
+    return false;
+#endif
+}
+
+void* VPrePipeline::threadMain(void* pipelinep) {
+    static_cast<VPrePipeline*>(pipelinep)->produce();
+    return NULL;
+}
+
+size_t VPrePipeline::getText(char* bufp, size_t max_size) {
+    // Consumer: return queued text, and run calls as the producer reaches them
+    while (m_textPos >= m_text.length()) {
+	lock();
+	while (m_queue.empty() && !m_callp && !m_eof) wait();
+	if (!m_queue.empty()) {
+	    m_text.swap(m_queue.front());
+	    m_textPos = 0;
+	    m_queueBytes -= m_text.length();
+	    m_queue.pop_front();
+	    signal();
+	    unlock();
+	} else if (m_callp) {
+	    // Queue is empty, so all text before the call has been read
+	    VPreProc::PipelineCall* callp = m_callp;
+	    unlock();
+	    callp->run();
+	    lock();
+	    if (callp->m_abort) { m_abort = true; m_aborted = true; }
+	    m_callp = NULL;
+	    m_callDone = true;
+	    signal();
+	    unlock();
+	} else {
+	    unlock();
+	    return 0;
+	}
+    }
+    size_t len = m_text.length() - m_textPos;
+    if (len > max_size) len = max_size;
+    memcpy(bufp, m_text.data()+m_textPos, len);
+    m_textPos += len;
+    return len;
+}
+
+void VPrePipeline::call(VPreProc::PipelineCall& call) {
+    // Producer: have the consumer run the call, and wait for it
+    resume();  // Consumer may pause us while we wait
+    lock();
+    m_callp = &call;
+    m_callDone = false;
+    signal();
+    while (!m_callDone && !m_abort) wait();
+    bool abort = m_abort;
+    if (!m_callDone) m_callp = NULL;  // Consumer is gone
+    unlock();
+    pause();
+    if (abort) throw VPreProc::PipelineAbort();
+}
+
 
 VPreProc::VPreProc() {
     VPreProcImp* idatap = new VPreProcImp();
@@ -254,6 +1422,7 @@ void VPreProc::configure(VFileLine* filelinep) {
 }
 
 VPreProc::~VPreProc() {
+    pipelineStop();
     if (m_opaquep) { delete m_opaquep; m_opaquep = NULL; }
 }
 
@@ -267,11 +1436,83 @@ void VPreProc::openFile(string filename, VFileLine* filelinep) {
 }
 string VPreProc::getline() {
     VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
-    return idatap->getparseline(true,0);
+    if (!idatap->m_profilep) return idatap->getparseline(true,0);
+    idatap->m_profilep->resume();
+    string out = idatap->getparseline(true,0);
+    idatap->m_profilep->pause();
+    return out;
 }
 string VPreProc::getall(size_t approx_chunk) {
     VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
-    return idatap->getparseline(false,approx_chunk);
+    if (!idatap->m_profilep) return idatap->getparseline(false,approx_chunk);
+    idatap->m_profilep->resume();
+    string out = idatap->getparseline(false,approx_chunk);
+    idatap->m_profilep->pause();
+    return out;
+}
+size_t VPreProc::getText(char* bufp, size_t max_size) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    if (idatap->m_pipelinep) {
+	size_t len = idatap->m_pipelinep->getText(bufp, max_size);
+	if (!len) pipelineStop();  // Finished
+	return len;
+    }
+    if (!idatap->m_profilep) return idatap->getText(bufp, max_size);
+    idatap->m_profilep->resume();
+    size_t len = idatap->getText(bufp, max_size);
+    idatap->m_profilep->pause();
+    return len;
+}
+string VPreProc::getPending() {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    if (idatap->m_pipelinep) return "";  // Any text is still queued for getText
+    // Only whole lines; a partial line is what getline would still be waiting on
+    string::size_type end = idatap->m_lineChars.rfind('\n');
+    if (end == string::npos || end < idatap->m_lineStart) return "";
+    string out (idatap->m_lineChars, idatap->m_lineStart, end + 1 - idatap->m_lineStart);
+    idatap->lineCharsConsume(out.length());
+    return out;
+}
+bool VPreProc::pipelineStart() {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    if (idatap->m_pipelinep) return true;
+    idatap->m_pipelineAborted = false;
+    idatap->m_pipelinep = new VPrePipeline(idatap);
+    if (!idatap->m_pipelinep->start()) {
+	delete idatap->m_pipelinep; idatap->m_pipelinep = NULL;
+	return false;
+    }
+    return true;
+}
+void VPreProc::pipelineStop() {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    if (!idatap || !idatap->m_pipelinep) return;
+    VPrePipeline* pipelinep = idatap->m_pipelinep;
+    pipelinep->stop();  // Joins thread
+    idatap->m_pipelinep = NULL;
+    idatap->m_pipelineAborted = pipelinep->aborted();
+    delete pipelinep;
+}
+void VPreProc::pipelinePause() {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    if (idatap->m_pipelinep) idatap->m_pipelinep->pause();
+}
+void VPreProc::pipelineResume() {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    if (idatap->m_pipelinep) idatap->m_pipelinep->resume();
+}
+bool VPreProc::pipelineThread() const {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    return idatap->m_pipelinep && idatap->m_pipelinep->isProducer();
+}
+bool VPreProc::pipelineAborted() const {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    return idatap->m_pipelinep ? idatap->m_pipelinep->aborted() : idatap->m_pipelineAborted;
+}
+void VPreProc::pipelineCall(PipelineCall& call) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    if (!pipelineThread()) { call.run(); return; }
+    idatap->m_pipelinep->call(call);
 }
 void VPreProc::debug(int level) {
     VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
@@ -282,7 +1523,7 @@ void VPreProc::debug(int level) {
 }
 bool VPreProc::isEof() {
     VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
-    return idatap->isEof();
+    return idatap->isEof() && !idatap->lineCharsPending();
 }
 VFileLine* VPreProc::fileline() {
     VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
@@ -292,6 +1533,341 @@ void VPreProc::insertUnreadback(string text) {
     VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
     return idatap->insertUnreadback(text);
 }
+void VPreProc::insertText(const string& text) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    idatap->lineCharsAppend(text);
+}
+void VPreProc::profile(bool flag) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    if (flag && !idatap->m_profilep) idatap->m_profilep = new VPreProfile();
+    else if (!flag && idatap->m_profilep) { delete idatap->m_profilep; idatap->m_profilep = NULL; }
+}
+const VPreProfile* VPreProc::profile() const {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    return idatap->m_profilep;
+}
+void VPreProc::defUse(bool flag) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    if (flag && !idatap->m_defUsep) idatap->m_defUsep = new VPreDefUse();
+    else if (!flag && idatap->m_defUsep) { delete idatap->m_defUsep; idatap->m_defUsep = NULL; }
+}
+const VPreDefUse* VPreProc::defUse() const {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    return idatap->m_defUsep;
+}
+void VPreProc::stats(map<string,size_t>& statsr) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    idatap->stats(statsr);
+}
+size_t VPreProc::includeCacheLimit() {
+    return VPreFileCache::singleton().limit();
+}
+void VPreProc::includeCacheLimit(size_t bytes) {
+    VPreFileCache::singleton().limit(bytes);
+}
+bool VPreProc::includeCacheHash() {
+    return VPreFileCache::singleton().contentHash();
+}
+void VPreProc::includeCacheHash(bool flag) {
+    VPreFileCache::singleton().contentHash(flag);
+}
+void VPreProc::includeCacheStats(map<string,size_t>& statsr) {
+    VPreFileCache::singleton().stats(statsr);
+}
+void VPreProc::includePath(const vector<string>& dirs, const vector<string>& exts) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    idatap->m_incDirs.clear();
+    set<string> seen;
+    for (vector<string>::const_iterator it=dirs.begin(); it!=dirs.end(); ++it) {
+	if (seen.insert(*it).second) idatap->m_incDirs.push_back(*it);
+    }
+    idatap->m_incExts.clear();
+    idatap->m_incExts.push_back("");
+    idatap->m_incExts.insert(idatap->m_incExts.end(), exts.begin(), exts.end());
+}
+string VPreProc::resolveFile(const string& filename) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    // Leave environment variables to the caller
+    if (filename.empty() || filename.find('$') != string::npos || filename[0] == '~') return "";
+    if (VPreDirCache::readableFile(filename)) return filename;
+    for (vector<string>::const_iterator dirIt=idatap->m_incDirs.begin(); dirIt!=idatap->m_incDirs.end(); ++dirIt) {
+	for (vector<string>::const_iterator extIt=idatap->m_incExts.begin(); extIt!=idatap->m_incExts.end(); ++extIt) {
+	    string found = *dirIt+"/"+filename+*extIt;
+	    if (VPreDirCache::singleton().exists(found)) return found;
+	}
+    }
+    return "";
+}
+void VPreProc::includeDirCacheFlush() {
+    VPreDirCache::singleton().clear();
+}
+bool VPreProc::lineMap(bool flag) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    if (flag && !idatap->m_lineMapp) {
+	// Line counts must start with the first text returned, and each
+	// line must be returned for the counts to match the consumer's
+	if (idatap->lineCharsPending() || idatap->m_pipelinep || !keepWhitespace()) return false;
+	idatap->m_lineMapp = new VPreLineMap();
+	// Where output starts, normally replacing the opening `line
+	idatap->m_lineMapp->add(idatap->m_finFilelinep->filename(), idatap->m_finFilelinep->lineno());
+    }
+    else if (!flag && idatap->m_lineMapp) { delete idatap->m_lineMapp; idatap->m_lineMapp = NULL; }
+    return true;
+}
+bool VPreProc::lineMap() const {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    return idatap->m_lineMapp != NULL;
+}
+bool VPreProc::nextLineMark(size_t fromLine, VPreLineMark& markr) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    return idatap->m_lineMapp && idatap->m_lineMapp->next(fromLine, markr);
+}
+string VPreProc::writeFd(VPreTextSource* sourcep, int fd, WriteBuf& bufr) {
+    // Fill the buffer before each write, as pipeline chunks are smaller
+    static const size_t WRITE_SIZE = 1024*1024;
+    bufr.m_buf.resize(WRITE_SIZE);
+    while (true) {
+	size_t got = sourcep->readText(&bufr.m_buf[bufr.m_len], WRITE_SIZE-bufr.m_len);
+	bufr.m_len += got;
+	if (got && bufr.m_len < WRITE_SIZE) continue;
+	string err = writeFlush(fd, bufr);
+	if (err != "" || !got) return err;
+    }
+}
+
+string VPreProc::writeFlush(int fd, WriteBuf& bufr) {
+    for (size_t off = 0; off < bufr.m_len; ) {
+	errno = 0;
+	ssize_t wrote = ::write(fd, bufr.m_buf.data()+off, bufr.m_len-off);
+	if (wrote > 0) off += wrote;
+	else if (wrote < 0 && errno == EINTR) {}
+	else { bufr.m_len = 0; return strerror(errno ? errno : EIO); }
+    }
+    bufr.m_len = 0;
+    return "";
+}
+
+//*************************************************************************
+// VPreDefTable Methods
+
+void VPreDefTable::undefineall() {
+    for (DefMap::iterator it=m_defs.begin(); it!=m_defs.end(); ) {
+	if (!it->second.m_cmdline) m_defs.erase(it++);
+	else ++it;
+    }
+}
+string VPreDefTable::defParams(const string& name) const {
+    const Entry* entp = find(name);
+    if (!entp) return "";
+    // "0" indicates defined without formal parameters
+    return entp->m_hasParams ? entp->m_params : "0";
+}
+string VPreDefTable::defValue(const string& name) const {
+    const Entry* entp = find(name);
+    return entp ? entp->m_value : "";
+}
+bool VPreDefTable::cmdlineSame(const VPreDefTable& other) const {
+    size_t count = 0;
+    for (DefMap::const_iterator it=m_defs.begin(); it!=m_defs.end(); ++it) {
+	if (!it->second.m_cmdline) continue;
+	const Entry* otherp = other.find(it->first);
+	if (!otherp || !otherp->m_cmdline
+	    || otherp->m_value != it->second.m_value
+	    || otherp->m_hasParams != it->second.m_hasParams
+	    || otherp->m_params != it->second.m_params) return false;
+	++count;
+    }
+    for (DefMap::const_iterator it=other.m_defs.begin(); it!=other.m_defs.end(); ++it) {
+	if (it->second.m_cmdline) --count;
+    }
+    return count == 0;
+}
+
+//*************************************************************************
+// Define Template Methods
+
+void VPreProc::defineTemplates(bool flag) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    idatap->m_defTemplatesOn = flag;
+    idatap->m_defTemplates.clear();
+}
+void VPreProc::defineChanged(const string& name) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    idatap->m_defTemplates.erase(name);
+}
+void VPreProc::defineChangedAll() {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    idatap->m_defTemplates.clear();
+}
+
+//*************************************************************************
+// Snapshot Methods
+
+static const char* const VPRE_SNAPSHOT_MAGIC = "VPreSnapshot 1\n";
+
+string VPreProc::snapshot(const VPreDefTable& defs) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    string out = VPRE_SNAPSHOT_MAGIC;
+    VPreSnapWriter w(out);
+    const map<string,VPreFileIdent>& files = idatap->m_depFiles;
+    w.num(files.size());
+    for (map<string,VPreFileIdent>::const_iterator it=files.begin(); it!=files.end(); ++it) {
+	w.str(it->first);
+	it->second.snapWrite(w);
+    }
+    w.num(defs.defs().size());
+    for (VPreDefTable::DefMap::const_iterator it=defs.defs().begin(); it!=defs.defs().end(); ++it) {
+	w.str(it->first);
+	w.str(it->second.m_value);
+	w.str(it->second.m_params);
+	w.num((it->second.m_hasParams ? 1 : 0) | (it->second.m_cmdline ? 2 : 0));
+    }
+    // Guards of those files, so including them again is skipped
+    vector<pair<string,VPreGuardTable::Guard> > guards;
+    for (map<string,VPreFileIdent>::const_iterator it=files.begin(); it!=files.end(); ++it) {
+	VPreGuardTable::Guard guard;
+	if (VPreGuardTable::singleton().lookup(it->first, it->second, guard/*ref*/)) {
+	    guards.push_back(make_pair(it->first, guard));
+	}
+    }
+    w.num(guards.size());
+    for (size_t i=0; i<guards.size(); ++i) {
+	w.str(guards[i].first);
+	w.str(guards[i].second.m_guard);
+	w.num(guards[i].second.m_cmtOutside ? 1 : 0);
+    }
+    return out;
+}
+
+bool VPreProc::snapshotRestore(const string& data, VPreDefTable& defsr, string& whyr) {
+    VPreProcImp* idatap = static_cast<VPreProcImp*>(m_opaquep);
+    string magic = VPRE_SNAPSHOT_MAGIC;
+    if (0 != data.compare(0, magic.length(), magic)) {
+	whyr = "Not a snapshot, or from another version";
+	return false;
+    }
+    VPreSnapReader r(data, magic.length());
+    map<string,VPreFileIdent> files;
+    for (unsigned long n = r.num(); n && r.ok(); --n) {
+	string filename = r.str();
+	files[filename].snapRead(r);
+    }
+    VPreDefTable defs;
+    for (unsigned long n = r.num(); n && r.ok(); --n) {
+	string name = r.str();
+	VPreDefTable::Entry ent;
+	ent.m_value = r.str();
+	ent.m_params = r.str();
+	unsigned long flags = r.num();
+	ent.m_hasParams = (flags & 1) != 0;
+	ent.m_cmdline = (flags & 2) != 0;
+	defs.define(name, ent);
+    }
+    vector<VPreGuardDetect> guards;
+    for (unsigned long n = r.num(); n && r.ok(); --n) {
+	string filename = r.str();
+	VPreGuardDetect det(NULL, filename, files[filename], 0);
+	det.m_guard = r.str();
+	det.m_cmtOutside = r.num() != 0;
+	guards.push_back(det);
+    }
+    if (!r.ok()) {
+	whyr = "Truncated snapshot";
+	return false;
+    }
+    // Stale if any file it read has changed since
+    for (map<string,VPreFileIdent>::const_iterator it=files.begin(); it!=files.end(); ++it) {
+	VPreFileIdent ident;
+	if (!ident.stat(it->first) || !(ident == it->second)) {
+	    whyr = "File changed since snapshot: "+it->first;
+	    return false;
+	}
+    }
+    // Command line defines may have changed what was defined
+    if (!defs.cmdlineSame(defsr)) {
+	whyr = "Command line defines differ from snapshot";
+	return false;
+    }
+    defsr = defs;
+    idatap->m_defTemplates.clear();
+    for (size_t i=0; i<guards.size(); ++i) {
+	VPreGuardTable::singleton().learn(guards[i]);
+    }
+    idatap->m_depFiles.insert(files.begin(), files.end());
+    return true;
+}
+
+//**********************************************************************
+// VPreProfile Methods
+
+static double profileWallSeconds() {
+#if defined(_WIN32) && !defined(__CYGWIN__)
+    return (double)clock() / CLOCKS_PER_SEC;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+#endif
+}
+
+double VPreProfile::seconds() const {
+    return m_activeSec + (m_running ? (profileWallSeconds() - m_resumeSec) : 0);
+}
+void VPreProfile::resume() {
+    if (m_running) return;
+    m_resumeSec = profileWallSeconds();
+    m_running = true;
+}
+void VPreProfile::pause() {
+    if (!m_running) return;
+    m_activeSec += profileWallSeconds() - m_resumeSec;
+    m_running = false;
+}
+void VPreProfile::fileEnter(const string& filename, const void* keyp) {
+    FileEnt& ent = m_files[filename];
+    ent.m_opens++;
+    ent.m_active++;
+    Frame frame;
+    frame.m_entp = &ent;
+    frame.m_keyp = keyp;
+    frame.m_startSec = seconds();
+    frame.m_childSec = 0;
+    m_frames.push_back(frame);
+}
+void VPreProfile::fileExit(const void* keyp) {
+    // Close the file's frame, and any that didn't see their own exit
+    double now = seconds();
+    while (!m_frames.empty()) {
+	Frame frame = m_frames.back();
+	m_frames.pop_back();
+	double incl = now - frame.m_startSec;
+	frame.m_entp->m_exclSec += incl - frame.m_childSec;
+	// A file including itself is only charged once inclusively
+	if (--frame.m_entp->m_active == 0) frame.m_entp->m_inclSec += incl;
+	if (!m_frames.empty()) m_frames.back().m_childSec += incl;
+	if (frame.m_keyp == keyp) break;
+    }
+}
+
+double VPreProc::prepassRate(size_t bytes) {
+    static const char line[] = "  assign sig_name[31:0] = other_sig[31:0] & mask;  // comment\r\n";
+    string text;
+    text.reserve(bytes + sizeof(line));
+    while (text.length() < bytes) text += line;
+    double startSec = profileWallSeconds();
+    preprocStripCrNul(&text[0], text.length());
+    double secs = profileWallSeconds() - startSec;
+    return (secs > 0) ? (text.length() / secs) : 0;
+}
+
+string VPreProc::prepassStrip(const string& text, bool bytewise) {
+    string out = text;
+    if (out.empty()) return out;
+    size_t len = (bytewise ? (preprocStripCrNulBytes(&out[0], &out[0], &out[0]+out.length()) - &out[0])
+		  : preprocStripCrNul(&out[0], out.length()));
+    out.resize(len);
+    return out;
+}
 
 //**********************************************************************
 // Parser Utilities
@@ -373,59 +1949,38 @@ string VPreProcImp::trimWhitespace(const string& strg, bool trailing) {
     return out;
 }
 
-string VPreProcImp::defineSubst(VPreDefRef* refp) {
-    // Substitute out defines in a define reference.
-    // (We also need to call here on non-param defines to handle `")
-    // We could push the define text back into the lexer, but that's slow
-    // and would make recursive definitions and parameter handling nasty.
-    //
-    // Note we parse the definition parameters and value here.  If a
-    // parametrized define is used many, many times, we could cache the
-    // parsed result.
-    if (debug()>=5) {
-	cout<<"defineSubstIn  `"<<refp->name()<<" "<<refp->params()<<endl;
-	for (unsigned i=0; i<refp->args().size(); i++) {
-	    cout<<"defineArg["<<i<<"] = '"<<refp->args()[i]<<"'"<<endl;
-	}
-    }
-    // Grab value
-    string value = m_preprocp->defValue(refp->name());
-    if (debug()>=5) cout<<"defineValue    '"<<VPreLex::cleanDbgStrg(value)<<"'"<<endl;
+void VPreProcImp::defineCompile(VPreDefTemplate& tmpl, const string& params, const string& value) {
+    // Parse a define's formal parameters and value, so defineSubst need only
+    // concatenate the compiled pieces.
+    tmpl.m_formals.clear();
+    tmpl.m_segments.clear();
 
-    map<string,string> argValueByName;
-    {   // Parse argument list into map
-	unsigned numArgs=0;
+    map<string,int> argIndexByName;
+    {   // Parse argument list
 	string argName;
 	int paren = 1;  // (), {} and [] can use same counter, as must be matched pair per spec
 	string token;
 	bool quote = false;
 	bool haveDefault = false;
 	// Note there's a leading ( and trailing ), so parens==1 is the base parsing level
-	string params = refp->params();  // Must keep str in scope to get pointer
 	const char* cp=params.c_str();
 	if (*cp == '(') cp++;
 	for (; *cp; cp++) {
-	    //if (debug()>=5) cout <<"   Parse  Paren="<<paren<<"  Arg="<<numArgs<<"  token='"<<token<<"'  Parse="<<cp<<endl;
 	    if (!quote && paren==1) {
 		if (*cp==')' || *cp==',') {
 		    string valueDef;
 		    if (haveDefault) { valueDef=token; } else { argName=token; }
 		    argName = trimWhitespace(argName,true);
-		    if (debug()>=5) cout<<"    Got Arg="<<numArgs<<"  argName='"<<argName<<"'  default='"<<valueDef<<"'"<<endl;
-		    // Parse it
+		    if (debug()>=5) cout<<"    Got Arg="<<tmpl.m_formals.size()<<"  argName='"<<argName<<"'  default='"<<valueDef<<"'"<<endl;
 		    if (argName!="") {
-			if (refp->args().size() > numArgs) {
-			    // A call `def( a ) must be equivelent to `def(a ), so trimWhitespace
-			    // At one point we didn't trim trailing whitespace, but this confuses `"
-			    string arg = trimWhitespace(refp->args()[numArgs], true);
-			    if (arg != "") valueDef = arg;
-			} else if (!haveDefault) {
-			    error("Define missing argument '"+argName+"' for: "+refp->name()+"\n");
-			    return " `"+refp->name()+" ";
-			}
-			numArgs++;
+			VPreDefTemplate::Formal formal;
+			formal.m_name = argName;
+			formal.m_default = valueDef;
+			formal.m_hasDefault = haveDefault;
+			// A repeated name refers to the last argument with that name
+			argIndexByName[argName] = tmpl.m_formals.size();
+			tmpl.m_formals.push_back(formal);
 		    }
-		    argValueByName[argName] = valueDef;
 		    // Prepare for next
 		    argName = "";
 		    token = "";
@@ -452,16 +2007,10 @@ string VPreProcImp::defineSubst(VPreDefRef* refp) {
 	    if (*cp=='"') quote=!quote;
 	    if (*cp) token += *cp;
 	}
-	if (refp->args().size() > numArgs
-	    // `define X() is ok to call with nothing
-	    && !(refp->args().size()==1 && numArgs==0 && trimWhitespace(refp->args()[0],false)=="")) {
-	    error("Define passed too many arguments: "+refp->name()+"\n");
-	    return " `"+refp->name()+" ";
-	}
     }
 
-    string out = "";
-    {   // Parse substitution define using arguments
+    string out = "";  // Literal text since last argument
+    {   // Parse substitution define into literals and arguments
 	string argName;
 	bool quote = false;
 	bool backslashesc = false;  // In \.....{space} block
@@ -472,26 +2021,18 @@ string VPreProcImp::defineSubst(VPreDefRef* refp) {
 	    else if (isspace(*cp)) { backslashesc = false; }
 	    // We don't check for quotes; some simulators expand even inside quotes
 	    if ( isalpha(*cp) || *cp=='_'
-		 || *cp=='$' // Won't replace system functions, since no $ in argValueByName
+		 || *cp=='$' // Won't replace system functions, since no $ in argIndexByName
 		 || (argName!="" && (isdigit(*cp) || *cp=='$'))) {
 		argName += *cp;
 		continue;
 	    }
 	    if (argName != "") {
 		// Found a possible variable substitution
-		map<string,string>::iterator iter = argValueByName.find(argName);
-		if (iter != argValueByName.end()) {
-		    // Substitute
-		    string subst = iter->second;
-		    if (subst == "") {
-			// Normally `` is removed later, but with no token after, we're otherwise
-			// stuck, so remove proceeding ``
-			if (out.size()>=2 && out.substr(out.size()-2) == "``") {
-			    out = out.substr(0, out.size()-2);
-			}
-		    } else {
-			out += subst;
-		    }
+		map<string,int>::iterator iter = argIndexByName.find(argName);
+		if (iter != argIndexByName.end()) {
+		    if (out != "") tmpl.m_segments.push_back(VPreDefTemplate::Segment(out, -1));
+		    tmpl.m_segments.push_back(VPreDefTemplate::Segment("", iter->second));
+		    out = "";
 		} else {
 		    out += argName;
 		}
@@ -504,7 +2045,7 @@ string VPreProcImp::defineSubst(VPreDefRef* refp) {
 			// Don't put out the ``, we're forming an escape which will not expand further later
 		    } else {
 			out += "``";   // `` must get removed later, as `FOO```BAR must pre-expand FOO and BAR
-			// See also removal in empty substitutes above
+			// See also removal of empty arguments in defineSubst
 		    }
 		    cp++;
 		    continue;
@@ -552,70 +2093,127 @@ string VPreProcImp::defineSubst(VPreDefRef* refp) {
 	    if (*cp) out += *cp;
 	}
     }
-
-    if (debug()>=5) cout<<"defineSubstOut '"<<VPreLex::cleanDbgStrg(out)<<"'"<<endl;
-    return out;
+    if (out != "") tmpl.m_segments.push_back(VPreDefTemplate::Segment(out, -1));
 }
 
-//**********************************************************************
-// Parser routines
-
-bool VPreProcImp::readWholefile(const string& filename, StrList& outl) {
-// If change this code, run a test with the below size set very small
-//#define INFILTER_IPC_BUFSIZ 16
-#define INFILTER_IPC_BUFSIZ 64*1024
-    char buf[INFILTER_IPC_BUFSIZ];
+string VPreProcImp::defineSubst(VPreDefRef* refp) {
+    // Substitute out defines in a define reference.
+    // (We also need to call here on non-param defines to handle `")
+    // We could push the define text back into the lexer, but that's slow
+    // and would make recursive definitions and parameter handling nasty.
+    //
+    // The definition parameters and value are compiled on first use, then
+    // reused until the define changes, see defineTemplates.
+    if (debug()>=5) {
+	cout<<"defineSubstIn  `"<<refp->name()<<" "<<refp->params()<<endl;
+	for (unsigned i=0; i<refp->args().size(); i++) {
+	    cout<<"defineArg["<<i<<"] = '"<<refp->args()[i]<<"'"<<endl;
+	}
+    }
+    // Grab value
+    if (m_defUsep) m_defUsep->value(refp->name());
+    string value = m_preprocp->defValue(refp->name());
+    if (debug()>=5) cout<<"defineValue    '"<<VPreLex::cleanDbgStrg(value)<<"'"<<endl;
 
-    FILE* fp = NULL;
-    int fd;
-    bool eof = false;
+    // Changes to the define forget the template, see defineChanged.  If
+    // the define callbacks can't say when that is, compile every time.
+    VPreDefTemplate tmplOnce;
+    VPreDefTemplate& tmpl = m_defTemplatesOn ? m_defTemplates[refp->name()] : tmplOnce;
+    if (!tmpl.m_valid) {
+	defineCompile(tmpl, refp->params(), value);
+	tmpl.m_valid = m_defTemplatesOn;
+    }
 
-    if (filename.length()>3 && 0==filename.compare(filename.length()-3, 3, ".gz")) {
-	string cmd = "gunzip -c "+filename;
-        if ((fp = popen(cmd.c_str(), "r")) == NULL) {
-            return false;
-        }
-        fd = fileno(fp);
-    } else {
-        fd = open(filename.c_str(), O_RDONLY);
-        if (fd<0) return false;
+    // Determine value of each argument
+    vector<string> argValues;  argValues.reserve(tmpl.m_formals.size());
+    for (unsigned i=0; i<tmpl.m_formals.size(); i++) {
+	const VPreDefTemplate::Formal& formal = tmpl.m_formals[i];
+	string valueDef = formal.m_hasDefault ? formal.m_default : "";
+	if (refp->args().size() > i) {
+	    // A call `def( a ) must be equivelent to `def(a ), so trimWhitespace
+	    // At one point we didn't trim trailing whitespace, but this confuses `"
+	    string arg = trimWhitespace(refp->args()[i], true);
+	    if (arg != "") valueDef = arg;
+	} else if (!formal.m_hasDefault) {
+	    error("Define missing argument '"+formal.m_name+"' for: "+refp->name()+"\n");
+	    return " `"+refp->name()+" ";
+	}
+	argValues.push_back(valueDef);
     }
-    while (!eof) {
-	ssize_t todo = INFILTER_IPC_BUFSIZ;
-	errno = 0;
-	ssize_t got = read(fd, buf, todo);
-	if (got>0) {
-	    outl.push_back(string(buf, got));
+    if (refp->args().size() > tmpl.m_formals.size()
+	// `define X() is ok to call with nothing
+	&& !(refp->args().size()==1 && tmpl.m_formals.empty() && trimWhitespace(refp->args()[0],false)=="")) {
+	error("Define passed too many arguments: "+refp->name()+"\n");
+	return " `"+refp->name()+" ";
+    }
+
+    string out = "";
+    for (vector<VPreDefTemplate::Segment>::const_iterator it=tmpl.m_segments.begin();
+	 it!=tmpl.m_segments.end(); ++it) {
+	if (it->m_arg < 0) {
+	    out += it->m_text;
+	} else {
+	    const string& subst = argValues[it->m_arg];
+	    if (subst == "") {
+		// Normally `` is removed later, but with no token after, we're otherwise
+		// stuck, so remove proceeding ``
+		if (out.size()>=2 && out.compare(out.size()-2, 2, "``") == 0) {
+		    out.erase(out.size()-2);
+		}
+	    } else {
+		out += subst;
+	    }
 	}
-	else if (errno == EINTR || errno == EAGAIN
-#ifdef EWOULDBLOCK
-		 || errno == EWOULDBLOCK
-#endif
-	    ) {
-	} else { eof = true; break; }
     }
 
-    if (fp) { pclose(fp); fp=NULL; }
-    else close(fd);
-    return true;
+    if (debug()>=5) cout<<"defineSubstOut '"<<VPreLex::cleanDbgStrg(out)<<"'"<<endl;
+    return out;
 }
 
+//**********************************************************************
+// Parser routines
+
+
 void VPreProcImp::openFile(string filename, VFileLine* filelinep) {
     // Open a new file, possibly overriding the current one which is active.
 
-    // Read a list<string> with the whole file.
-    StrList wholefile;
-    bool ok = readWholefile(filename, wholefile/*ref*/);
-    if (!ok) {
+    // Use the include cache, or map (and decompress) the file if we can,
+    // otherwise read from a pipe.  Either way the lexer pulls characters as
+    // needed, so memory doesn't grow with the size of the file.
+    string filtercmd;
+    VPreStreamSource* sourcep = NULL;
+    VPreFileIdent ident;
+    bool regular = ident.stat(filename);
+    if (regular) m_depFiles[filename] = ident;
+    if (!isEof() && regular) {  // Only includes
+	// Skip a file we've seen before if its include guard is still defined
+	string guard;
+	bool guarded = VPreGuardTable::singleton().find(filename, ident, m_lexp->m_keepComments, guard/*ref*/);
+	if (guarded && m_defUsep) m_defUsep->ifdef(guard);  // Charged to the includer
+	if (guarded && m_preprocp->defExists(guard)) {
+	    if (debug()>=5) cout<<"Include guard "<<guard<<" skips "<<filename<<endl;
+	    m_statGuardSkips++;
+	    return;
+	}
+	sourcep = preprocOpenCachedSource(filename, ident);
+    }
+    if (!sourcep) sourcep = preprocOpenSource(filename, filtercmd/*ref*/);
+    if (!sourcep) sourcep = VPreFdSource::openFile(filename, filtercmd);
+    if (!sourcep) {
 	error("File not found: "+filename+"\n");
 	return;
     }
 
-    if (!m_preprocp->isEof()) {  // IE not the first file.
+    if (isEof()) {
+	// Defines may have been changed from outside between files
+	m_defTemplates.clear();
+    }
+    if (!isEof()) {  // IE not the first file.
 	// We allow the same include file twice, because occasionally it pops
 	// up, with guards preventing a real recursion.
 	if (m_lexp->m_streampStack.size()>VPreProc::INCLUDE_DEPTH_MAX) {
 	    error("Recursive inclusion of file: "+filename);
+	    delete sourcep;
 	    return;
 	}
 	// There's already a file active.  Push it to work on the new one.
@@ -624,36 +2222,14 @@ void VPreProcImp::openFile(string filename, VFileLine* filelinep) {
 
     // Create new stream structure
     m_lexp->scanNewFile(m_preprocp->fileline()->create(filename, 1));
+    if (m_profilep) m_profilep->fileEnter(filename, m_lexp->curStreamp());
+    if (m_defUsep) m_defUsep->fileEnter(filename, m_lexp->curStreamp());
     addLineComment(1); // Enter
+    m_guardDetects.push_back(VPreGuardDetect(m_lexp->curStreamp(), filename, ident, m_ifdefStack.size()));
+    if (!regular) m_guardDetects.back().m_state = VPreGuardDetect::gs_FAIL;
 
-    // Filter all DOS CR's en-mass.  This avoids bugs with lexing CRs in the wrong places.
-    // This will also strip them from strings, but strings aren't supposed to be multi-line without a "\"
-    for (StrList::iterator it=wholefile.begin(); it!=wholefile.end(); ++it) {
-	// We don't end-loop at \0 as we allow and strip mid-string '\0's (for now).
-	bool strip = false;
-	const char* sp = it->data();
-	const char* ep = sp + it->length();
-	// Only process if needed, as saves extra string allocations
-	for (const char* cp=sp; cp<ep; cp++) {
-	    if (*cp == '\r' || *cp == '\0') {
-		strip = true; break;
-	    }
-	}
-	if (strip) {
-	    string out;  out.reserve(it->length());
-	    for (const char* cp=sp; cp<ep; cp++) {
-		if (!(*cp == '\r' || *cp == '\0')) {
-		    out += *cp;
-		}
-	    }
-	    *it = out;
-	}
-
-	// Push the data to an internal buffer.
-	m_lexp->scanBytesBack(*it);
-	// Reclaim memory; the push saved the string contents for us
-	*it = "";
-    }
+    // Characters are read and filtered as the lexer needs them
+    m_lexp->scanSourceBack(sourcep);
 }
 
 void VPreProcImp::insertUnreadbackAtBol(const string& text) {
@@ -668,34 +2244,45 @@ void VPreProcImp::insertUnreadbackAtBol(const string& text) {
 
 void VPreProcImp::addLineComment(int enter_exit_level) {
     if (m_preprocp->lineDirectives()) {
-	insertUnreadbackAtBol(m_lexp->curFilelinep()->lineDirectiveStrg(enter_exit_level));
+	if (m_lineMapp && !m_off && state()==ps_TOP) {
+	    // Sure to reach getFinalToken next, so the line map can take the location
+	    VPreLineLoc loc;
+	    loc.m_filename = m_lexp->curFilelinep()->filename();
+	    loc.m_lineno = m_lexp->curFilelinep()->lineno();
+	    loc.m_enterExit = enter_exit_level;
+	    m_lineLocs.push_back(loc);
+	    insertUnreadbackAtBol(VPRE_LINE_MARK);
+	} else {
+	    insertUnreadbackAtBol(m_lexp->curFilelinep()->lineDirectiveStrg(enter_exit_level));
+	}
     }
 }
 
-int VPreProcImp::getRawToken() {
+template <bool Profile> int VPreProcImp::getRawToken() {
     // Get a token from the file, whatever it may be.
     while (1) {
       next_tok:
+	m_rawOffWhite = false;
 	if (m_lineAdd) {
 	    m_lineAdd--;
 	    m_rawAtBol = true;
-	    yyourtext("\n",1);
+	    m_lexp->yyourtext("\n",1);
 	    if (debug()>=5) debugToken(VP_WHITE, "LNA");
 	    return (VP_WHITE);
 	}
 	if (m_lineCmt!="") {
 	    // We have some `line directive or other processed data to return to the user.
-	    static string rtncmt;  // Keep the c string till next call
+	    string& rtncmt = m_lexp->m_rtnText;  // Keep the c string till next call
 	    rtncmt = m_lineCmt;
 	    if (m_lineCmtNl) {
 		if (!m_rawAtBol) rtncmt = "\n"+rtncmt;
 		m_lineCmtNl = false;
 	    }
-	    yyourtext(rtncmt.c_str(), rtncmt.length());
+	    m_lexp->yyourtext(rtncmt.c_str(), rtncmt.length());
 	    m_lineCmt = "";
-	    if (yyourleng()) m_rawAtBol = (yyourtext()[yyourleng()-1]=='\n');
+	    if (m_lexp->yyourleng()) m_rawAtBol = (m_lexp->yyourtext()[m_lexp->yyourleng()-1]=='\n');
 	    if (state()==ps_DEFVALUE) {
-		VPreLex::s_currentLexp->appendDefValue(yyourtext(),yyourleng());
+		m_lexp->appendDefValue(m_lexp->yyourtext(),m_lexp->yyourleng());
 		goto next_tok;
 	    } else {
 		if (debug()>=5) debugToken(VP_TEXT, "LCM");
@@ -705,23 +2292,97 @@ int VPreProcImp::getRawToken() {
 	if (isEof()) return (VP_EOF);
 
 	// Snarf next token from the file
-	int tok = m_lexp->lex();
+	int tok;
+	size_t offBytes = 0;  // Bytes lexOff skipped, as returned text may be abbreviated
+	if (m_off && state()==ps_TOP && m_defRefs.empty()) {
+	    // Disabled by `ifdef, so can skip text without lexing it
+	    offBytes = m_lexp->m_offSkipBytes;
+	    tok = m_lexp->lexOff();
+	    offBytes = m_lexp->m_offSkipBytes - offBytes;
+	    m_rawOffWhite = (tok == VP_WHITE);
+	} else {
+	    tok = m_lexp->lex();
+	}
 
 	if (debug()>=5) debugToken(tok, "RAW");
 
 	// A EOF on an include, so we can print `line and detect mis-matched "s
 	if (tok==VP_EOF) {
+	    if (m_lexp->curStreamp()->m_file) endOfOneFile();
 	    goto next_tok;  // find the EOF, after adding needed lines
 	}
+	if (Profile) m_profilep->token(offBytes ? offBytes : m_lexp->yyourleng(), m_off);
+	if (!m_guardDetects.empty()) guardToken(tok);
 
-	if (yyourleng()) m_rawAtBol = (yyourtext()[yyourleng()-1]=='\n');
+	if (m_lexp->yyourleng()) m_rawAtBol = (m_lexp->yyourtext()[m_lexp->yyourleng()-1]=='\n');
 	return tok;
     }
 }
 
+void VPreProcImp::guardToken(int tok) {
+    // Track if the file being read is entirely within a `ifndef include guard
+    VPreGuardDetect& det = m_guardDetects.back();
+    size_t depth = m_ifdefStack.size();
+    switch (det.m_state) {
+    case VPreGuardDetect::gs_FAIL:
+	return;
+    case VPreGuardDetect::gs_INSIDE:
+	// Anything goes inside, but the guard's `ifndef must not have a `else
+	if (depth == det.m_ifdefDepth+1) {
+	    if (tok==VP_ENDIF && state()==ps_TOP) det.m_state = VPreGuardDetect::gs_ENDED;
+	    else if (tok==VP_ENDIF || tok==VP_ELSE || tok==VP_ELSIF) det.m_state = VPreGuardDetect::gs_FAIL;
+	} else if (depth <= det.m_ifdefDepth) {
+	    det.m_state = VPreGuardDetect::gs_FAIL;
+	}
+	return;
+    case VPreGuardDetect::gs_NAME:
+	if (tok==VP_SYMBOL && state()==ps_DEFNAME_IFNDEF) {
+	    det.m_guard.assign(m_lexp->yyourtext(),m_lexp->yyourleng());
+	    det.m_state = VPreGuardDetect::gs_INSIDE;
+	    return;
+	}
+	break;
+    case VPreGuardDetect::gs_START:
+	if (tok==VP_IFNDEF && state()==ps_TOP && depth==det.m_ifdefDepth) {
+	    det.m_state = VPreGuardDetect::gs_NAME;
+	    return;
+	}
+	break;
+    default:
+	break;
+    }
+    // Outside the guard only whitespace, and comments that aren't output, may appear
+    if (tok==VP_WHITE) return;
+    if (tok==VP_COMMENT && !m_lexp->m_keepComments) { det.m_cmtOutside = true; return; }
+    det.m_state = VPreGuardDetect::gs_FAIL;
+}
+
+void VPreProcImp::endOfOneFile() {
+    // Reached EOF of a file (not the final EOF stream).  Learn its include guard.
+    if (m_profilep) m_profilep->fileExit(m_lexp->curStreamp());
+    if (m_defUsep) m_defUsep->fileExit(m_lexp->curStreamp());
+    while (!m_guardDetects.empty()) {
+	VPreGuardDetect& det = m_guardDetects.back();
+	bool match = (det.m_streamp == m_lexp->curStreamp());
+	if (match && det.m_state == VPreGuardDetect::gs_ENDED) {
+	    if (debug()>=5) cout<<"Include guard "<<det.m_guard<<" found for "<<det.m_filename<<endl;
+	    VPreGuardTable::singleton().learn(det);
+	} else if (match) {
+	    VPreGuardTable::singleton().forget(det.m_filename);
+	}
+	m_guardDetects.pop_back();
+	if (match) break;
+    }
+}
+
+void VPreProcImp::stats(map<string,size_t>& statsr) {
+    statsr["include_guard_skips"] = m_statGuardSkips;
+    statsr["ifdef_skip_bytes"] = m_lexp->m_offSkipBytes;
+}
+
 void VPreProcImp::debugToken(int tok, const char* cmtp) {
     if (debug()>=5) {
-	string buf = string(yyourtext(), yyourleng());
+	string buf = string(m_lexp->yyourtext(), m_lexp->yyourleng());
 	string::size_type pos;
 	while ((pos=buf.find("\n")) != string::npos) { buf.replace(pos, 1, "\\n"); }
 	while ((pos=buf.find("\r")) != string::npos) { buf.replace(pos, 1, "\\r"); }
@@ -735,19 +2396,19 @@ void VPreProcImp::debugToken(int tok, const char* cmtp) {
 // Sorry, we're not using bison/yacc. It doesn't handle returning white space
 // in the middle of parsing other tokens.
 
-int VPreProcImp::getStateToken(string& buf) {
+template <bool Profile> int VPreProcImp::getStateToken(string& buf) {
     // Return the next state-determined token
     while (1) {
       next_tok:
 	if (isEof()) {
-	    buf = string(yyourtext(), yyourleng());
+	    buf = string(m_lexp->yyourtext(), m_lexp->yyourleng());
 	    return VP_EOF;
 	}
-	int tok = getRawToken();
+	int tok = getRawToken<Profile>();
 
 	// Most states emit white space and comments between tokens. (Unless collecting a string)
 	if (tok==VP_WHITE && state() !=ps_STRIFY) {
-	    buf = string(yyourtext(), yyourleng());
+	    buf = string(m_lexp->yyourtext(), m_lexp->yyourleng());
 	    return (tok);
 	}
 	if (tok==VP_BACKQUOTE && state() !=ps_STRIFY) { tok = VP_TEXT; }
@@ -755,12 +2416,12 @@ int VPreProcImp::getStateToken(string& buf) {
 	    if (!m_off) {
 		if (m_lexp->m_keepComments == KEEPCMT_SUB
 		    || m_lexp->m_keepComments == KEEPCMT_EXP) {
-		    string rtn; rtn.assign(yyourtext(),yyourleng());
+		    string rtn; rtn.assign(m_lexp->yyourtext(),m_lexp->yyourleng());
 		    m_preprocp->comment(rtn);
 		    // Need to insure "foo/**/bar" becomes two tokens
 		    insertUnreadback(" ");
 		} else if (m_lexp->m_keepComments) {
-		    buf = string(yyourtext(), yyourleng());
+		    buf = string(m_lexp->yyourtext(), m_lexp->yyourleng());
 		    return (tok);
 		} else {
 		    // Need to insure "foo/**/bar" becomes two tokens
@@ -770,7 +2431,7 @@ int VPreProcImp::getStateToken(string& buf) {
 	    // We're off or processed the comment specially.  If there are newlines
 	    // in it, we also return the newlines as TEXT so that the linenumber
 	    // count is maintained for downstream tools
-	    for (size_t len=0; len<(size_t)yyourleng(); len++) { if (yyourtext()[len]=='\n') m_lineAdd++; }
+	    for (size_t len=0; len<(size_t)m_lexp->yyourleng(); len++) { if (m_lexp->yyourtext()[len]=='\n') m_lineAdd++; }
 	    goto next_tok;
 	}
 	if (tok==VP_LINE) {
@@ -790,11 +2451,12 @@ int VPreProcImp::getStateToken(string& buf) {
 	    //	`define Q1 `QA()``_b  // -> a_b
 	    // This may be a side effect of how `UNDEFINED remains as `UNDEFINED,
 	    // but it screws up our method here.  So hardcode it.
-	    string name(yyourtext()+1,yyourleng()-1);
+	    string name(m_lexp->yyourtext()+1,m_lexp->yyourleng()-1);
+	    if (m_defUsep) m_defUsep->ifdef(name);
 	    if (m_preprocp->defExists(name)) {   // JOIN(DEFREF)
 		// Put back the `` and process the defref
 		if (debug()>=5) cout<<"```: define "<<name<<" exists, expand first\n";
-		m_defPutJoin = true;  // After define, unputString("``").  Not now as would lose yyourtext()
+		m_defPutJoin = true;  // After define, unputString("``").  Not now as would lose m_lexp->yyourtext()
 		if (debug()>=5) cout<<"TOKEN now DEFREF\n";
 		tok = VP_DEFREF;
 	    } else {  // DEFREF(JOIN)
@@ -804,7 +2466,7 @@ int VPreProcImp::getStateToken(string& buf) {
 	}
 	if (tok==VP_SYMBOL_JOIN || tok==VP_DEFREF_JOIN || tok==VP_JOIN) {  // not else if, can fallthru from above if()
 	    // a`` -> string doesn't include the ``, so can just grab next and continue
-	    string out(yyourtext(),yyourleng());
+	    string out(m_lexp->yyourtext(),m_lexp->yyourleng());
 	    if (debug()>=5) cout<<"`` LHS:"<<out<<endl;
 	    // a``b``c can have multiple joins, so we need a stack
 	    m_joinStack.push(out);
@@ -823,9 +2485,10 @@ int VPreProcImp::getStateToken(string& buf) {
 	case ps_DEFNAME_IFNDEF:	// FALLTHRU
 	case ps_DEFNAME_ELSIF: {
 	    if (tok==VP_SYMBOL) {
-		m_lastSym.assign(yyourtext(),yyourleng());
+		m_lastSym.assign(m_lexp->yyourtext(),m_lexp->yyourleng());
 		if (state()==ps_DEFNAME_IFDEF
 		    || state()==ps_DEFNAME_IFNDEF) {
+		    if (m_defUsep) m_defUsep->ifdef(m_lastSym);
 		    bool enable = m_preprocp->defExists(m_lastSym);
 		    if (debug()>=5) cout<<"Ifdef "<<m_lastSym<<(enable?" ON":" OFF")<<endl;
 		    if (state()==ps_DEFNAME_IFNDEF) enable = !enable;
@@ -842,6 +2505,7 @@ int VPreProcImp::getStateToken(string& buf) {
 			VPreIfEntry lastIf = m_ifdefStack.top(); m_ifdefStack.pop();
 			if (!lastIf.on()) parsingOn();
 			// Handle `if portion
+			if (m_defUsep && !lastIf.everOn()) m_defUsep->ifdef(m_lastSym);
 			bool enable = !lastIf.everOn() && m_preprocp->defExists(m_lastSym);
 			if (debug()>=5) cout<<"Elsif "<<m_lastSym<<(enable?" ON":" OFF")<<endl;
 			m_ifdefStack.push(VPreIfEntry(enable, lastIf.everOn()));
@@ -853,6 +2517,8 @@ int VPreProcImp::getStateToken(string& buf) {
 		else if (state()==ps_DEFNAME_UNDEF) {
 		    if (!m_off) {
 			if (debug()>=5) cout<<"Undef "<<m_lastSym<<endl;
+			m_defTemplates.erase(m_lastSym);
+			if (m_defUsep) m_defUsep->write(m_lastSym);
 			m_preprocp->undef(m_lastSym);
 		    }
 		    statePop();
@@ -870,7 +2536,7 @@ int VPreProcImp::getStateToken(string& buf) {
 	    else if (tok==VP_TEXT) {
 		// IE, something like comment between define and symbol
 		if (!m_off) {
-		    buf = string(yyourtext(), yyourleng());
+		    buf = string(m_lexp->yyourtext(), m_lexp->yyourleng());
 		    return tok;
 		}
 		else goto next_tok;
@@ -894,7 +2560,7 @@ int VPreProcImp::getStateToken(string& buf) {
 	    } else if (tok==VP_TEXT) {
 		// IE, something like comment in formals
 		if (!m_off) {
-		    buf = string(yyourtext(), yyourleng());
+		    buf = string(m_lexp->yyourtext(), m_lexp->yyourleng());
 		    return tok;
 		}
 		else goto next_tok;
@@ -904,8 +2570,7 @@ int VPreProcImp::getStateToken(string& buf) {
 	    }
 	}
 	case ps_DEFVALUE: {
-	    static string newlines;
-	    newlines = "\n";  // Always start with trailing return
+	    string newlines = "\n";  // Always start with trailing return
 	    if (tok == VP_DEFVALUE) {
 		if (debug()>=5) cout<<"DefValue='"<<VPreLex::cleanDbgStrg(m_lexp->m_defValue)
 				    <<"'  formals='"<<VPreLex::cleanDbgStrg(m_formals)<<"'\n";
@@ -933,6 +2598,8 @@ int VPreProcImp::getStateToken(string& buf) {
 		    // Define it
 		    if (debug()>=5) cout<<"Define "<<m_lastSym<<" "<<formals
 					<<" = '"<<VPreLex::cleanDbgStrg(value)<<"'"<<endl;
+		    m_defTemplates.erase(m_lastSym);
+		    if (m_defUsep) m_defUsep->write(m_lastSym);
 		    m_preprocp->define(m_lastSym, value, formals);
 		}
 	    } else {
@@ -946,7 +2613,7 @@ int VPreProcImp::getStateToken(string& buf) {
 	    return(VP_WHITE);
 	}
 	case ps_DEFPAREN: {
-	    if (tok==VP_TEXT && yyourleng()==1 && yyourtext()[0]=='(') {
+	    if (tok==VP_TEXT && m_lexp->yyourleng()==1 && m_lexp->yyourtext()[0]=='(') {
 		stateChange(ps_DEFARG);
 		goto next_tok;
 	    } else {
@@ -962,13 +2629,13 @@ int VPreProcImp::getStateToken(string& buf) {
 	    VPreDefRef* refp = &(m_defRefs.top());
 	    refp->nextarg(refp->nextarg()+m_lexp->m_defValue); m_lexp->m_defValue="";
 	    if (debug()>=5) cout<<"defarg++ "<<refp->nextarg()<<endl;
-	    if (tok==VP_DEFARG && yyourleng()==1 && yyourtext()[0]==',') {
+	    if (tok==VP_DEFARG && m_lexp->yyourleng()==1 && m_lexp->yyourtext()[0]==',') {
 		refp->args().push_back(refp->nextarg());
 		stateChange(ps_DEFARG);
 		m_lexp->pushStateDefArg(1);
 		refp->nextarg("");
 		goto next_tok;
-	    } else if (tok==VP_DEFARG && yyourleng()==1 && yyourtext()[0]==')') {
+	    } else if (tok==VP_DEFARG && m_lexp->yyourleng()==1 && m_lexp->yyourtext()[0]==')') {
 		// Substitute in and prepare for next action
 		// Similar code in non-parenthesized define (Search for END_OF_DEFARG)
 		refp->args().push_back(refp->nextarg());
@@ -976,6 +2643,7 @@ int VPreProcImp::getStateToken(string& buf) {
 		if (!m_off) {
 		    out = defineSubst(refp);
 		    out = m_preprocp->defSubstitute(out);
+		    if (Profile) m_profilep->define(refp->name(), out.length(), m_defDepth);
 		}
 		m_defRefs.pop();  refp=NULL;
 		if (m_defRefs.empty()) {
@@ -1008,7 +2676,7 @@ int VPreProcImp::getStateToken(string& buf) {
 		// we'll append it when we push the argument.
 		break;
 	    } else if (tok==VP_SYMBOL || tok==VP_STRING || tok==VP_TEXT || tok==VP_WHITE || tok==VP_PSL) {
-		string rtn; rtn.assign(yyourtext(),yyourleng());
+		string rtn; rtn.assign(m_lexp->yyourtext(),m_lexp->yyourleng());
 		refp->nextarg(refp->nextarg()+rtn);
 		goto next_tok;
 	    } else if (tok==VP_STRIFY) {
@@ -1024,7 +2692,7 @@ int VPreProcImp::getStateToken(string& buf) {
 	case ps_INCNAME: {
 	    if (tok==VP_STRING) {
 		statePop();
-		m_lastSym.assign(yyourtext(),yyourleng());
+		m_lastSym.assign(m_lexp->yyourtext(),m_lexp->yyourleng());
 		if (debug()>=5) cout<<"Include "<<m_lastSym<<endl;
 		// Drop leading and trailing quotes.
 		m_lastSym.erase(0,1);
@@ -1032,7 +2700,7 @@ int VPreProcImp::getStateToken(string& buf) {
 		m_preprocp->include(m_lastSym);
 		goto next_tok;
 	    }
-	    else if (tok==VP_TEXT && yyourleng()==1 && yyourtext()[0]=='<') {
+	    else if (tok==VP_TEXT && m_lexp->yyourleng()==1 && m_lexp->yyourtext()[0]=='<') {
 		// include <filename>
 		stateChange(ps_INCNAME);  // Still
 		m_lexp->pushStateIncFilename();
@@ -1052,7 +2720,7 @@ int VPreProcImp::getStateToken(string& buf) {
 	case ps_ERRORNAME: {
 	    if (tok==VP_STRING) {
 		if (!m_off) {
-		    m_lastSym.assign(yyourtext(),yyourleng());
+		    m_lastSym.assign(m_lexp->yyourtext(),m_lexp->yyourleng());
 		    error(m_lastSym);
 		}
 		statePop();
@@ -1069,7 +2737,7 @@ int VPreProcImp::getStateToken(string& buf) {
 		if (m_joinStack.empty()) fatalSrc("`` join stack empty, but in a ``");
 		string lhs = m_joinStack.top(); m_joinStack.pop();
 		if (debug()>=5) cout<<"`` LHS:"<<lhs<<endl;
-		string rhs(yyourtext(),yyourleng());
+		string rhs(m_lexp->yyourtext(),m_lexp->yyourleng());
 		if (debug()>=5) cout<<"`` RHS:"<<rhs<<endl;
 		string out = lhs+rhs;
 		if (debug()>=5) cout<<"`` Out:"<<out<<endl;
@@ -1120,7 +2788,7 @@ int VPreProcImp::getStateToken(string& buf) {
 	    }
 	    else {
 		// Append token to eventual string
-		m_strify.append(yyourtext(),yyourleng());
+		m_strify.append(m_lexp->yyourtext(),m_lexp->yyourleng());
 		goto next_tok;
 	    }
 	}
@@ -1175,7 +2843,7 @@ int VPreProcImp::getStateToken(string& buf) {
 
 	case VP_DEFREF: {
 	    // m_off not right here, but inside substitution, to make this work: `ifdef NEVER `DEFUN(`endif)
-	    string name(yyourtext()+1,yyourleng()-1);
+	    string name(m_lexp->yyourtext()+1,m_lexp->yyourleng()-1);
 	    if (debug()>=5) cout<<"DefRef "<<name<<endl;
 	    if (m_defPutJoin) { m_defPutJoin = false; unputString("``"); }
 	    if (m_defDepth++ > VPreProc::DEFINE_RECURSION_LEVEL_MAX) {
@@ -1183,6 +2851,7 @@ int VPreProcImp::getStateToken(string& buf) {
 		goto next_tok;
 	    }
 	    // Substitute
+	    if (m_defUsep) m_defUsep->value(name);
 	    string params = m_preprocp->defParams(name);
 	    if (params=="") {   // Not found, return original string as-is
 		m_defDepth = 0;
@@ -1202,6 +2871,7 @@ int VPreProcImp::getStateToken(string& buf) {
 		}
 		// Similar code in parenthesized define (Search for END_OF_DEFARG)
 		out = m_preprocp->defSubstitute(out);
+		if (Profile && !m_off) m_profilep->define(name, out.length(), m_defDepth);
 		if (m_defRefs.empty()) {
 		    // Just output the substitution
 		    if (state() == ps_JOIN) {  // Handle {left}```FOO where `FOO might be empty
@@ -1243,11 +2913,13 @@ int VPreProcImp::getStateToken(string& buf) {
 	    if (!m_ifdefStack.empty()) {
 		error("`ifdef not terminated at EOF\n");
 	    }
-	    buf = string(yyourtext(), yyourleng());
+	    buf = string(m_lexp->yyourtext(), m_lexp->yyourleng());
 	    return tok;
 	case VP_UNDEFINEALL:
 	    if (!m_off) {
 		if (debug()>=5) cout<<"Undefineall "<<endl;
+		m_defTemplates.clear();
+		if (m_defUsep) m_defUsep->undefineall();
 		m_preprocp->undefineall();
 	    }
 	    goto next_tok;
@@ -1263,7 +2935,7 @@ int VPreProcImp::getStateToken(string& buf) {
 	case VP_TEXT: {
 	    m_defDepth = 0;
 	    if (!m_off) {
-		buf = string(yyourtext(), yyourleng());
+		buf = string(m_lexp->yyourtext(), m_lexp->yyourleng());
 		return tok;
 	    }
 	    else goto next_tok;
@@ -1276,20 +2948,42 @@ int VPreProcImp::getStateToken(string& buf) {
 	    fatalSrc((string)"Internal error: Unexpected token "+tokenName(tok)+"\n");
 	    break;
 	}
-	buf = string(yyourtext(), yyourleng());
+	buf = string(m_lexp->yyourtext(), m_lexp->yyourleng());
 	return tok;
     }
 }
 
-int VPreProcImp::getFinalToken(string& buf) {
+template <bool Profile> int VPreProcImp::getFinalToken(string& buf) {
     // Return the next user-visible token in the input stream.
     // Includes and such are handled here, and are never seen by the caller.
     if (!m_finAhead) {
 	m_finAhead = true;
-	m_finToken = getStateToken(m_finBuf);
+	m_finToken = getStateToken<Profile>(m_finBuf);
+	m_finLineRest = false;
+    } else if (m_finNextLine) {
+	m_finNextLine = false;
+	m_lexp->m_tokFilelinep->linenoIncInPlace();  // lexOff gave the token its own fileline
     }
     int tok = m_finToken;
     buf = m_finBuf;
+    bool lineRest = m_finLineRest;
+    // lexOff returns the whitespace of many disabled lines as one token.
+    // Hand it out a line at a time, as if each were its own token, so the
+    // fileline and `line tracking follow each line start.
+    // With a line map, each of several `line in one token is also split
+    // off, so m_finFilelinep gives each location in turn.
+    size_t rest = 0;
+    string::size_type nl = string::npos;
+    if (tok == VP_WHITE && m_rawOffWhite) {
+	nl = buf.find('\n');
+    } else if (tok == VP_TEXT && (m_lineMapp || !m_lineLocs.empty())) {
+	string::size_type cmd = buf.find_first_not_of('\n');
+	if (cmd != string::npos && 0==buf.compare(cmd, 6, "`line ")) nl = buf.find('\n', cmd);
+    }
+    if (nl != string::npos && nl+1 < buf.length()) {
+	rest = buf.length()-(nl+1);
+	buf.erase(nl+1);
+    }
     if (0 && debug()>=5) {
 	string bufcln = VPreLex::cleanDbgStrg(buf);
 	fprintf(stderr,"%d: FIN:      %-10s: %s\n",
@@ -1298,12 +2992,23 @@ int VPreProcImp::getFinalToken(string& buf) {
     // Track `line
     const char* bufp = buf.c_str();
     while (*bufp == '\n') bufp++;
+    m_finLine = false;
     if ((tok == VP_TEXT || tok == VP_LINE) && 0==strncmp(bufp,"`line ",6)) {
-	int enter;
-	m_finFilelinep = m_finFilelinep->lineDirective(bufp, enter/*ref*/);
+	if (0==strcmp(bufp, VPRE_LINE_MARK)) {
+	    const VPreLineLoc& loc = m_lineLocs.front();
+	    m_finFilelinep = m_finFilelinep->create(loc.m_filename, loc.m_lineno);
+	    if (!m_lineMapp) {  // Line map since turned off, so give the text after all
+		buf = string(buf.c_str(), bufp) + m_finFilelinep->lineDirectiveStrg(loc.m_enterExit);
+	    }
+	    m_lineLocs.pop_front();
+	} else {
+	    int enter;
+	    m_finFilelinep = m_finFilelinep->lineDirective(bufp, enter/*ref*/);
+	}
+	m_finLine = true;
     }
     else {
-	if (m_finAtBol && !(tok==VP_TEXT && buf=="\n")
+	if (m_finAtBol && !(tok==VP_TEXT && buf=="\n") && !lineRest
 	    && m_preprocp->lineDirectives()) {
 	    if (int outBehind = m_lexp->m_tokFilelinep->lineno() - m_finFilelinep->lineno()) {
 		if (debug()>=5) fprintf(stderr,"%d: FIN: readjust, fin at %d  request at %d\n",
@@ -1319,7 +3024,9 @@ int VPreProcImp::getFinalToken(string& buf) {
 		    }
 		} else {
 		    // Need to backup, use `line
-		    buf = m_finFilelinep->lineDirectiveStrg(0);
+		    // (With a line map the caller takes m_finFilelinep instead)
+		    buf = m_lineMapp ? "" : m_finFilelinep->lineDirectiveStrg(0);
+		    m_finLine = true;
 		    return VP_LINE;
 		}
 	    }
@@ -1334,22 +3041,99 @@ int VPreProcImp::getFinalToken(string& buf) {
 	    }
 	}
     }
-    m_finAhead = false;  // Consumed the token
+    if (rest) {
+	m_finBuf.erase(0, m_finBuf.length()-rest);
+	if (tok == VP_TEXT) m_finLineRest = true;
+	else if (m_lexp->m_offIgnLines) m_lexp->m_offIgnLines--;
+	else m_finNextLine = true;
+    } else {
+	m_finAhead = false;  // Consumed the token
+    }
     return tok;
 }
 
+const char* VPreProcImp::lineCharsNewline() {
+    // Return first unreturned newline in m_lineChars, or NULL.
+    // Characters are only searched once, however many tokens are appended.
+    if (m_lineScanned < m_lineStart) m_lineScanned = m_lineStart;
+    const char* startp = m_lineChars.data();
+    const char* nlp = (const char*)memchr(startp+m_lineScanned, '\n', m_lineChars.length()-m_lineScanned);
+    m_lineScanned = nlp ? (nlp-startp) : m_lineChars.length();
+    return nlp;
+}
+
+void VPreProcImp::lineCharsAppend(const string& text) {
+    // Add text to be returned, counting lines for the line map
+    m_lineChars.append(text);
+    if (m_lineMapp && !text.empty()) {
+	for (const char* cp = text.data(); (cp = (const char*)memchr(cp, '\n', text.data()+text.length()-cp)); ++cp) {
+	    ++m_lineMapp->m_outLines;
+	}
+	m_lineMapp->m_outAtBol = (text[text.length()-1] == '\n');
+    }
+}
+
+void VPreProcImp::lineMapMark(const string& text) {
+    // Put the location of a `line in the line map rather than the text.
+    // getFinalToken has already moved m_finFilelinep there, and only
+    // newlines may precede the directive in the token.
+    string::size_type nls = text.find_first_not_of('\n');
+    if (nls == string::npos) nls = text.length();
+    if (nls) lineCharsAppend(text.substr(0, nls));
+    if (!m_lineMapp->m_outAtBol) lineCharsAppend("\n");
+    m_lineMapp->add(m_finFilelinep->filename(), m_finFilelinep->lineno());
+}
+
+void VPreProcImp::lineCharsConsume(size_t len) {
+    // Remove returned characters.  The front is only erased once over half
+    // the buffer is returned, so each character is moved at most once.
+    m_lineStart += len;
+    if (m_lineStart >= m_lineChars.length()) {
+	m_lineChars.clear();
+	m_lineStart = 0;
+	m_lineScanned = 0;
+    } else if (m_lineStart > m_lineChars.length()/2) {
+	m_lineChars.erase(0, m_lineStart);
+	m_lineScanned = (m_lineScanned > m_lineStart) ? (m_lineScanned - m_lineStart) : 0;
+	m_lineStart = 0;
+    }
+}
+
 string VPreProcImp::getparseline(bool stop_at_eol, size_t approx_chunk) {
     // Get a single line from the parse stream.  Buffer unreturned text until the newline.
-    if (isEof()) return "";
+    size_t len = getparseLength(stop_at_eol, approx_chunk);
+    string theLine(m_lineChars, m_lineStart, len);
+    lineCharsConsume(len);
+    return theLine;
+}
+
+size_t VPreProcImp::getText(char* bufp, size_t max_size) {
+    // Copy up to max_size characters to return into bufp, 0 at EOF
+    size_t len = m_lineChars.length() - m_lineStart;
+    if (!len) len = getparseLength(false, max_size);
+    if (len > max_size) len = max_size;
+    memcpy(bufp, m_lineChars.data()+m_lineStart, len);
+    lineCharsConsume(len);
+    return len;
+}
+
+template <bool Profile> size_t VPreProcImp::getparseLength(bool stop_at_eol, size_t approx_chunk) {
+    // Fill m_lineChars with a line, or at least approx_chunk characters.
+    // Return the length of text from m_lineStart to return, 0 at EOF.
+    if (isEof()) {
+	// Only text from insertText can remain
+	const char* rtnp = stop_at_eol ? lineCharsNewline() : NULL;
+	return rtnp ? (rtnp-m_lineChars.data()-m_lineStart+1) : (m_lineChars.length()-m_lineStart);
+    }
     while (1) {
 	const char* rtnp = NULL;
 	bool gotEof = false;
 	while ((stop_at_eol
-		? (NULL==(rtnp=strchr(m_lineChars.c_str(),'\n')))
-		: (approx_chunk==0 || (m_lineChars.length() < approx_chunk)))
+		? (NULL==(rtnp=lineCharsNewline()))
+		: (approx_chunk==0 || (m_lineChars.length()-m_lineStart < approx_chunk)))
 	       && !gotEof) {
 	    string buf;
-	    int tok = getFinalToken(buf/*ref*/);
+	    int tok = getFinalToken<Profile>(buf/*ref*/);
 	    if (debug()>=5) {
 		string bufcln = VPreLex::cleanDbgStrg(buf);
 		fprintf(stderr,"%d: GETFETC:  %-10s: %s\n",
@@ -1357,35 +3141,37 @@ string VPreProcImp::getparseline(bool stop_at_eol, size_t approx_chunk) {
 	    }
 	    if (tok==VP_EOF) {
 		// Add a final newline, if the user forgot the final \n.
-		if (m_lineChars != "" && m_lineChars[m_lineChars.length()-1] != '\n') {
-		    m_lineChars.append("\n");
+		if (m_lineChars.length() > m_lineStart && m_lineChars[m_lineChars.length()-1] != '\n') {
+		    lineCharsAppend("\n");
 		}
 		gotEof = true;
 	    }
 	    else if (tok==VP_PSL) {
-		m_lineChars.append(" psl ");
+		lineCharsAppend(" psl ");
+	    }
+	    else if (m_finLine && m_lineMapp) {
+		lineMapMark(buf);
 	    }
 	    else {
-		m_lineChars.append(buf);
+		lineCharsAppend(buf);
 	    }
 	}
 
-	// Make new string with data up to the newline.
-	size_t len = stop_at_eol ? (rtnp-m_lineChars.c_str()+1) : m_lineChars.length();
-	string theLine(m_lineChars, 0, len);
-	m_lineChars = m_lineChars.erase(0,len);	// Remove returned characters
+	// Data up to the newline.
+	size_t len = rtnp ? (rtnp-m_lineChars.data()-m_lineStart+1) : (m_lineChars.length()-m_lineStart);
+	const char* linep = m_lineChars.data()+m_lineStart;
 
 	if (!m_preprocp->keepWhitespace() && !gotEof) {
-	    const char* cp=theLine.c_str();
-	    for (; *cp && (isspace(*cp) || *cp=='\n'); cp++) {}
-	    if (!*cp) continue;
+	    const char* cp = linep;
+	    for (; cp < linep+len && (isspace(*cp) || *cp=='\n'); cp++) {}
+	    if (cp == linep+len) { lineCharsConsume(len); continue; }
 	}
 
 	if (debug()>=4) {
-	    string lncln = VPreLex::cleanDbgStrg(theLine);
+	    string lncln = VPreLex::cleanDbgStrg(string(linep, len));
 	    fprintf(stderr,"%d: GETLINE:  %s\n",
 		    m_lexp->m_tokFilelinep->lineno(), lncln.c_str());
 	}
-	return theLine;
+	return len;
     }
 }
@@ -25,6 +25,8 @@
 
 #include <string>
 #include <map>
+#include <set>
+#include <vector>
 #include <iostream>
 using namespace std;
 #include "VFileLine.h"
@@ -34,6 +36,177 @@ struct VPreProcOpaque {
     virtual ~VPreProcOpaque() {}
 };
 class VDefine;
+class VPreTextSource;
+struct VPreLineMark;
+
+//**********************************************************************
+// VPreDefTable
+/// Table of defines held in C++.
+////
+/// A derived VPreProc may use this to implement the define callbacks, rather
+/// than looking up each define in the user's language.
+
+class VPreDefTable {
+public:
+    struct Entry {
+	string	m_value;	///< Value of define
+	string	m_params;	///< Formal parameter list, if m_hasParams
+	bool	m_hasParams;	///< Has formal parameter list
+	bool	m_cmdline;	///< Defined on command line; not removed by `undefineall
+	Entry() : m_hasParams(false), m_cmdline(false) {}
+    };
+    typedef map<string,Entry> DefMap;
+private:
+    DefMap	m_defs;		///< Definitions, by name
+public:
+    const DefMap& defs() const { return m_defs; }
+    const Entry* find(const string& name) const {
+	DefMap::const_iterator it = m_defs.find(name);
+	return (it == m_defs.end()) ? NULL : &(it->second);
+    }
+    void define(const string& name, const Entry& ent) { m_defs[name] = ent; }
+    void undef(const string& name) { m_defs.erase(name); }
+    void undefineall();		///< Remove all non-command-line definitions
+    void clear() { m_defs.clear(); }
+    bool cmdlineSame(const VPreDefTable& other) const;	///< Same command line definitions
+    string defParams(const string& name) const;	///< Same return as VPreProc::defParams
+    string defValue(const string& name) const;	///< Same return as VPreProc::defValue
+};
+
+//**********************************************************************
+// VPreProfile
+/// Preprocessing cost accounting, collected when VPreProc::profile is enabled.
+////
+/// Time is wall-clock time spent inside getline/getall, including define
+/// callbacks.  Bytes and tokens read from a macro expansion are charged to
+/// the file containing the reference.
+
+class VPreProfile {
+public:
+    struct FileEnt {
+	size_t	m_opens;	///< Times file was opened
+	size_t	m_bytes;	///< Bytes of tokens read while file was innermost
+	size_t	m_tokens;	///< Tokens read while file was innermost
+	size_t	m_skipBytes;	///< Bytes of m_bytes disabled by `ifdef
+	double	m_inclSec;	///< Seconds in file and the files it includes
+	double	m_exclSec;	///< Seconds in file, excluding what it includes
+	int	m_active;	///< Times on include stack now
+	FileEnt() : m_opens(0), m_bytes(0), m_tokens(0), m_skipBytes(0),
+		    m_inclSec(0), m_exclSec(0), m_active(0) {}
+    };
+    struct DefineEnt {
+	size_t	m_count;	///< Times substituted
+	size_t	m_bytes;	///< Bytes of substituted text
+	unsigned m_maxDepth;	///< Deepest `define nesting when substituted
+	DefineEnt() : m_count(0), m_bytes(0), m_maxDepth(0) {}
+    };
+    typedef map<string,FileEnt> FileMap;
+    typedef map<string,DefineEnt> DefineMap;
+private:
+    struct Frame {
+	FileEnt*	m_entp;		///< File being read
+	const void*	m_keyp;		///< Identifies the lexer stream of the file
+	double		m_startSec;	///< seconds() when entered
+	double		m_childSec;	///< Inclusive seconds of files included
+    };
+    FileMap	m_files;	///< Per file accounting, by filename
+    DefineMap	m_defines;	///< Per define accounting, by name
+    vector<Frame> m_frames;	///< Include stack
+    double	m_activeSec;	///< Seconds accumulated before m_resumeSec
+    double	m_resumeSec;	///< Wall time when last resumed
+    bool	m_running;	///< Between resume() and pause()
+public:
+    VPreProfile() : m_activeSec(0), m_resumeSec(0), m_running(false) {}
+    const FileMap& files() const { return m_files; }
+    const DefineMap& defines() const { return m_defines; }
+    double seconds() const;	///< Seconds inside the preprocessor so far
+    // Called by VPreProc as it works
+    void resume();
+    void pause();
+    void fileEnter(const string& filename, const void* keyp);
+    void fileExit(const void* keyp);
+    void token(size_t bytes, bool off) {
+	if (m_frames.empty()) return;
+	FileEnt* entp = m_frames.back().m_entp;
+	entp->m_tokens++;
+	entp->m_bytes += bytes;
+	if (off) entp->m_skipBytes += bytes;
+    }
+    void define(const string& name, size_t bytes, unsigned depth) {
+	DefineEnt& ent = m_defines[name];
+	ent.m_count++;
+	ent.m_bytes += bytes;
+	if (depth > ent.m_maxDepth) ent.m_maxDepth = depth;
+    }
+};
+
+//**********************************************************************
+// VPreDefUse
+/// Defines each file consulted or changed, collected when VPreProc::defUse is enabled.
+////
+/// A file's own uses are kept by filename; the uses of each top level file
+/// together with everything it included are also kept, by the top filename.
+/// An include guard test is charged to the file with the `include.
+
+class VPreDefUse {
+public:
+    struct Uses {
+	set<string>	m_ifdefs;	///< Existence tested by `ifdef/`ifndef/`elsif
+	set<string>	m_values;	///< Value or formals read by a `reference
+	set<string>	m_writes;	///< Changed by `define or `undef
+	bool		m_undefineall;	///< `undefineall was used
+	Uses() : m_undefineall(false) {}
+    };
+    typedef map<string,Uses> FileMap;
+private:
+    struct Frame {
+	Uses*		m_filep;	///< Uses of the file being read
+	Uses*		m_topp;		///< Uses of the top file it was included under
+	const void*	m_keyp;		///< Identifies the lexer stream of the file
+    };
+    FileMap	m_files;	///< Uses directly by each file, by filename
+    FileMap	m_tops;		///< Uses by each top file and its includes, by filename
+    vector<Frame> m_frames;	///< Include stack
+public:
+    const FileMap& files() const { return m_files; }
+    const FileMap& tops() const { return m_tops; }
+    // Called by VPreProc as it works
+    void fileEnter(const string& filename, const void* keyp) {
+	Frame frame;
+	frame.m_filep = &m_files[filename];
+	frame.m_topp = m_frames.empty() ? &m_tops[filename] : m_frames.back().m_topp;
+	frame.m_keyp = keyp;
+	m_frames.push_back(frame);
+    }
+    void fileExit(const void* keyp) {
+	// Close the file's frame, and any that didn't see their own exit
+	while (!m_frames.empty()) {
+	    bool done = (m_frames.back().m_keyp == keyp);
+	    m_frames.pop_back();
+	    if (done) break;
+	}
+    }
+    void ifdef(const string& name) {
+	if (m_frames.empty()) return;
+	m_frames.back().m_filep->m_ifdefs.insert(name);
+	m_frames.back().m_topp->m_ifdefs.insert(name);
+    }
+    void value(const string& name) {
+	if (m_frames.empty()) return;
+	m_frames.back().m_filep->m_values.insert(name);
+	m_frames.back().m_topp->m_values.insert(name);
+    }
+    void write(const string& name) {
+	if (m_frames.empty()) return;
+	m_frames.back().m_filep->m_writes.insert(name);
+	m_frames.back().m_topp->m_writes.insert(name);
+    }
+    void undefineall() {
+	if (m_frames.empty()) return;
+	m_frames.back().m_filep->m_undefineall = true;
+	m_frames.back().m_topp->m_undefineall = true;
+    }
+};
 
 //**********************************************************************
 // VPreProc
@@ -72,8 +245,18 @@ public:
     void debug(int level);	///< Set debugging level
     string getall(size_t approx_chunk);	///< Return all lines, or at least approx_chunk bytes. (Null if done.)
     string getline();		///< Return next line/lines. (Null if done.)
+    size_t getText(char* bufp, size_t max_size);	///< As getall, but copy into bufp. (0 if done.)
+    /// Take text already preprocessed but not returned, without reading
+    /// further, e.g. after a callback died in the middle of getText
+    string getPending();
     bool isEof();		///< Return true on EOF.
     void insertUnreadback(string text);
+    void insertText(const string& text);	///< Return already preprocessed text before any further input
+    void stats(map<string,size_t>& statsr);	///< Statistics counters by name
+    void profile(bool flag);	///< Enable collecting a VPreProfile, before reading
+    const VPreProfile* profile() const;	///< Profile collected, or NULL if not enabled
+    void defUse(bool flag);	///< Enable collecting a VPreDefUse
+    const VPreDefUse* defUse() const;	///< Define uses collected, or NULL if not enabled
 
     VFileLine* fileline();	///< File/Line number for last getline call
 
@@ -106,6 +289,98 @@ public:
     virtual string defValue(string name) = 0;	///< Return value of given define (should exist)
     virtual string defSubstitute(string substitute) = 0;	///< Return value to substitute for given post-parameter value
 
+    // PIPELINE
+    // Preprocessing may run on its own thread, with getText returning the
+    // text it produced.  Callbacks into other languages must instead be
+    // run by the thread calling getText, using pipelineCall.
+    /// Work to be done on the getText thread, see pipelineCall
+    class PipelineCall {
+    public:
+	bool m_abort;	///< Set by run() to stop preprocessing, e.g. after an error
+	PipelineCall() : m_abort(false) {}
+	virtual ~PipelineCall() {}
+	virtual void run() = 0;
+    };
+    struct PipelineAbort {};	///< Thrown on the pipeline thread to unwind after m_abort
+    /// Start preprocessing on a new thread; false if threads aren't supported
+    bool pipelineStart();
+    void pipelineStop();	///< Stop thread, discarding unread text
+    bool pipelineThread() const;	///< Called from the pipeline's thread
+    bool pipelineAborted() const;	///< A PipelineCall set m_abort
+    /// Hold the thread once it finishes the text it is producing, so the
+    /// preprocessor may be examined or changed.  Not from the thread itself.
+    void pipelinePause();
+    void pipelineResume();	///< Release the thread after pipelinePause
+    /// Run call on the getText thread, after the text produced before it is read
+    void pipelineCall(PipelineCall& call);
+
+    // DEFINE TEMPLATES
+    // Define values are compiled on first use.  Anything changing a define
+    // other than the `define and `undef being preprocessed must say so.
+    /// Keep compiled values (default); turn off if defValue/defParams may
+    /// give new results without these calls, e.g. computing them each time
+    void defineTemplates(bool flag);
+    void defineChanged(const string& name);	///< Forget compiled value of a define
+    void defineChangedAll();	///< Forget compiled values of all defines
+
+    // SNAPSHOT
+    // Define table, with include guards learned and files read so far,
+    // so a common prefix header can be processed once and restored
+    /// Return encoded state, with the given defines
+    string snapshot(const VPreDefTable& defs);
+    /// Restore from snapshot() into defsr; false with reason in whyr if
+    /// invalid, any file read has changed, or command line defines differ
+    bool snapshotRestore(const string& data, VPreDefTable& defsr, string& whyr);
+
+    // INCLUDE PATH
+    // Directory listings are read once and shared by all VPreProc's
+    /// Set directories and extensions searched by resolveFile
+    void includePath(const vector<string>& dirs, const vector<string>& exts);
+    /// Return filename, or first dir/filename+ext readable, as Verilog::Getopt::file_path.
+    /// Returns "" if not found, or filename needs environment substitution.
+    string resolveFile(const string& filename);
+    static void includeDirCacheFlush();	///< Forget directory listings
+
+    // LINE MAP
+    // For a consumer in this process, the location of the output lines can
+    // be kept in a map rather than as `line directives in the text
+    /// Start or stop keeping the map.  Can't start once text is waiting to
+    /// be returned, in which case returns false.
+    bool lineMap(bool flag);
+    bool lineMap() const;	///< Keeping a map
+    /// As VPreTextSource::nextLineMark
+    bool nextLineMark(size_t fromLine, VPreLineMark& markr);
+
+    // OUTPUT
+    /// Text read by writeFd but not yet written
+    struct WriteBuf {
+	string	m_buf;
+	size_t	m_len;	///< Bytes of m_buf to be written
+	WriteBuf() : m_len(0) {}
+    };
+    /// Write all text from sourcep, normally a VPreProc's readText, to file
+    /// descriptor fd in large writes.  Return "" or the error.  If reading
+    /// doesn't return, e.g. a callback died, the text before it is left in
+    /// bufr for writeFlush.
+    static string writeFd(VPreTextSource* sourcep, int fd, WriteBuf& bufr);
+    static string writeFlush(int fd, WriteBuf& bufr);	///< Write what bufr holds
+
+    // DIAGNOSTICS
+    /// Bytes per second of the input filter that removes CR and NUL,
+    /// timed on the given size of text with DOS line endings
+    static double prepassRate(size_t bytes);
+    /// Text with CR and NUL removed by the input filter, or with bytewise
+    /// true by its plain character loop, to check one against the other
+    static string prepassStrip(const string& text, bool bytewise);
+
+    // INCLUDE CACHE
+    // Contents of included files are cached and shared by all VPreProc's
+    static size_t includeCacheLimit();
+    static void includeCacheLimit(size_t bytes);	///< Maximum bytes to cache, 0=disable
+    static bool includeCacheHash();
+    static void includeCacheHash(bool flag);	///< Share storage of files with identical contents
+    static void includeCacheStats(map<string,size_t>& statsr);	///< Counters by name
+
     // UTILITIES
     void error(string msg) { fileline()->error(msg); }	///< Report a error
     void fatal(string msg) { fileline()->fatal(msg); }	///< Report a fatal error
@@ -0,0 +1,59 @@
+// -*- C++ -*-
+//*************************************************************************
+//
+// Copyright 2000-2021 by Wilson Snyder.  This program is free software;
+// you can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License Version 2.0.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+/// \file
+/// \brief Verilog::Preproc: Preprocessed text handed directly to a consumer
+///
+/// Authors: Wilson Snyder
+///
+/// Code available from: https://www.veripool.org/verilog-perl
+///
+/// The preprocessor and parser are separate shared libraries, so this
+/// interface is header only; the parser calls through the virtual table
+/// and never links against the preprocessor.
+///
+//*************************************************************************
+
+#ifndef _VPRETEXTSOURCE_H_
+#define _VPRETEXTSOURCE_H_ 1
+#include <string>
+using namespace std;
+
+//============================================================================
+// VPreLineMark
+/// Where an output line came from, given in place of a `line directive.
+
+struct VPreLineMark {
+    size_t	m_outLine;	///< Output line, counting newlines returned by readText from 0
+    string	m_filename;	///< File the line came from
+    int		m_lineno;	///< Line number in m_filename
+};
+
+//============================================================================
+// VPreTextSource
+/// Pulls preprocessed text as the consumer needs it.
+
+class VPreTextSource {
+public:
+    virtual ~VPreTextSource() {}
+    /// Copy up to max_size characters of text into bufp, straight from the
+    /// producer's buffer.  Return 0 only at end of input.
+    virtual size_t readText(char* bufp, size_t max_size) = 0;
+    /// When the text has no `line directives, put in markr the first
+    /// location change at or after output line fromLine and return true.
+    /// Return false if there is none in the text read so far, or the
+    /// text has `line directives.  fromLine must never decrease.
+    virtual bool nextLineMark(size_t /*fromLine*/, VPreLineMark& /*markr*/) { return false; }
+};
+
+#endif // Guard
@@ -0,0 +1,184 @@
+#!/usr/bin/perl -w
+# DESCRIPTION: Perl ExtUtils: Type 'make test' to test this package
+#
+# Copyright 2000-2021 by Wilson Snyder.  This program is free software;
+# you can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License Version 2.0.
+
+use IO::File;
+use strict;
+use Test::More;
+
+BEGIN { plan tests => 18 }
+BEGIN { require "./t/test_utils.pl"; }
+
+#######################################################################
+package MyPreprocDefValue;
+use Verilog::Preproc;
+use base qw(Verilog::Preproc);
+
+sub def_value { my $self = shift; return $self->SUPER::def_value(@_); }
+
+package MyPreprocRedefine;
+use Verilog::Preproc;
+use base qw(Verilog::Preproc);
+
+# Each `include redefines VAL from Perl instead
+sub include { my $self = shift; $self->define("VAL", "two y", "(y)"); }
+
+package MyPreprocCounter;
+use Verilog::Preproc;
+use base qw(Verilog::Preproc);
+
+# A new value on each substitution
+sub def_value {
+    my $self = shift;
+    return "v".(++$self->{_count}) if $_[0] eq "COUNTER";
+    return $self->SUPER::def_value(@_);
+}
+
+package main;
+#######################################################################
+
+use Verilog::Getopt;
+use Verilog::Preproc;
+ok(1, "use");
+
+sub prep {
+    my $opt = new Verilog::Getopt;
+    $opt->parameter (qw(
+			+incdir+verilog
+			+define+PREDEF_COMMAND_LINE
+			));
+    return $opt;
+}
+
+sub dump_defines {
+    my $opt = shift;
+    my $out = "";
+    foreach my $name ($opt->define_names_sorted) {
+	$out .= sprintf("%s %s %s %s\n", $name,
+			$opt->defparams($name),
+			$opt->defvalue($name),
+			$opt->defcmdline($name) ? 1 : 0);
+    }
+    return $out;
+}
+
+sub process {
+    my $class = shift;
+    my @args = @_;
+    my $opt = prep();
+    my $pp = $class->new(options=>$opt, @args);
+    my @warns;
+    local $SIG{__WARN__} = sub { push @warns, $_[0]; };
+    my $out = "";
+    foreach my $file (qw(inc1.v inc2.v inc_ifdef.v inc_nonl.v inc_def09.v)) {
+	$pp->open($file);
+	while (defined(my $line = $pp->getline())) {
+	    $out .= $line;
+	}
+    }
+    return ($pp, $out, dump_defines($opt), join('',@warns));
+}
+
+sub process_write_to {
+    my $to = shift;
+    my $pp = Verilog::Preproc->new(options=>prep(), native_defines=>1);
+    foreach my $file (qw(inc1.v inc2.v inc_ifdef.v inc_nonl.v inc_def09.v)) {
+	$pp->open($file);
+	$pp->write_to($to);
+    }
+}
+
+{
+    my ($pp, $out, $defs, $warns) = process("Verilog::Preproc");
+    ok(!$pp->{_native_defines}, "native off by default");
+    my ($npp, $nout, $ndefs, $nwarns) = process("Verilog::Preproc", native_defines=>1);
+    ok($npp->{_native_defines}, "native on");
+    is($nout, $out, "same output");
+    is($ndefs, $defs, "same defines stored back");
+    is($nwarns, $warns, "same warnings");
+}
+
+{
+    my ($pp, $out, $defs) = process("Verilog::Preproc", native_defines=>1);
+    my ($fpp, $fout, $fdefs) = process("Verilog::Preproc", native_defines=>1, native_file_path=>1);
+    ok($fpp->{_native_file_path}, "native file path on");
+    is($fout, $out, "same output with native file path");
+}
+
+{
+    my ($pp, $out) = process("Verilog::Preproc", native_defines=>1);
+    # write_to(filename) truncates, so only the last file is kept
+    process_write_to("test_dir/30_write_to.v");
+    my $last = wholefile("test_dir/30_write_to.v");
+    ok($last =~ /inc_def09\.v/ && $last !~ /inc1\.v/, "write_to filename");
+    my $fh = IO::File->new(">test_dir/30_write_to_fh.v") or die;
+    print $fh "prefix\n";
+    process_write_to($fh);
+    $fh->close;
+    is(wholefile("test_dir/30_write_to_fh.v"), "prefix\n".$out, "write_to file handle");
+}
+
+{
+    # A callback dying part way still writes the text before it, as getline does
+    write_file("test_dir/30_write_die.v", join('', map { "wire w$_;\n" } (1..20000))
+	       ."`include \"30_no_such_file.v\"\nwire after;\n");
+    my $getline_out = "";
+    my $pp = Verilog::Preproc->new(options=>prep(), native_defines=>1);
+    $pp->open("test_dir/30_write_die.v");
+    eval { while (defined(my $line = $pp->getline())) { $getline_out .= $line; } };
+    $pp = Verilog::Preproc->new(options=>prep(), native_defines=>1);
+    $pp->open("test_dir/30_write_die.v");
+    my $fh = IO::File->new(">test_dir/30_write_die.out") or die;
+    eval { $pp->write_to($fh); };
+    $fh->close;
+    is(wholefile("test_dir/30_write_die.out"), $getline_out, "write_to output before a callback died");
+}
+
+{
+    my ($pp) = process("MyPreprocDefValue", native_defines=>1);
+    ok(!$pp->{_native_defines}, "native off with def_value override");
+}
+
+{
+    my $opt = prep();
+    my $pp = Verilog::Preproc->new(options=>$opt, native_defines=>1);
+    $pp->define("NATIVE_DEF", "nvalue", "(a)");
+    ok(!defined $opt->defvalue_nowarn("NATIVE_DEF"), "options stale before sync");
+    is($pp->def_value("NATIVE_DEF"), "nvalue", "def_value from table");
+    $pp->sync_defines;
+    is($opt->defparams("NATIVE_DEF"), "(a)", "options updated by sync");
+}
+
+{
+    write_file("test_dir/30_redefine.v",
+	       "`define VAL(x) one x\n"
+	       ."a `VAL(1)\n"
+	       ."`include \"30_redefine.vh\"\n"
+	       ."b `VAL(2)\n");
+    foreach my $native (0, 1) {
+	my $pp = MyPreprocRedefine->new(options=>prep(), native_defines=>$native);
+	local $SIG{__WARN__} = sub {};  # Redefining warning
+	$pp->open("test_dir/30_redefine.v");
+	my $out = "";
+	while (defined(my $line = $pp->getline())) {
+	    $out .= $line;
+	}
+	like($out, qr/a one 1\n.*b two 2\n/s, "redefined from Perl, native_defines=>$native");
+    }
+}
+
+{
+    write_file("test_dir/30_counter.v", "`COUNTER `COUNTER `COUNTER\n");
+    my $opt = prep();
+    $opt->define("COUNTER", "v0");
+    my $pp = MyPreprocCounter->new(options=>$opt, line_directives=>0);
+    $pp->open("test_dir/30_counter.v");
+    my $out = "";
+    while (defined(my $line = $pp->getline())) {
+	$out .= $line;
+    }
+    like($out, qr/v1 v2 v3/, "def_value override called each substitution");
+}
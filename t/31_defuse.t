@@ -0,0 +1,68 @@
+#!/usr/bin/perl -w
+# DESCRIPTION: Perl ExtUtils: Type 'make test' to test this package
+#
+# Copyright 2000-2021 by Wilson Snyder.  This program is free software;
+# you can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License Version 2.0.
+
+use strict;
+use Test::More;
+
+BEGIN { plan tests => 12 }
+BEGIN { require "./t/test_utils.pl"; }
+
+#######################################################################
+
+use Verilog::Getopt;
+use Verilog::Preproc;
+ok(1, "use");
+
+write_file("test_dir/31_defuse.vh",
+	   "`ifndef DEFUSE_VH\n"
+	   ."`define DEFUSE_VH\n"
+	   ."`define DEFUSE_VAL val\n"
+	   ."`endif\n");
+write_file("test_dir/31_defuse_top.v",
+	   "`include \"31_defuse.vh\"\n"
+	   ."`ifdef DEFUSE_B\n"
+	   ."  b\n"
+	   ."`endif\n"
+	   ."a = `DEFUSE_VAL;\n"
+	   ."`undef DEFUSE_TMP\n");
+
+my $topname = "test_dir/31_defuse_top.v";
+{
+    my (undef, $pp) = preproc($topname);
+    my $uses = $pp->define_uses;
+    ok(!defined $uses, "no define_uses by default");
+}
+foreach my $native (0, 1) {
+    # Include guards are learned process-wide; learn this one here, so the
+    # top file tests it too whatever was read before
+    preproc($topname);
+    my (undef, $pp) = preproc($topname, define_uses=>1, native_defines=>$native);
+    my $uses = $pp->define_uses;
+    my $top = $uses->{files}{$topname};
+    my ($hname) = grep { /31_defuse\.vh$/ } keys %{$uses->{files}};
+    my $hdr = $uses->{files}{$hname||""};
+    is_deeply([$top->{ifdef}, $top->{value}, $top->{write}],
+	      [["DEFUSE_B", "DEFUSE_VH"], ["DEFUSE_VAL"], ["DEFUSE_TMP"]], "top file uses, native=$native");
+    is_deeply([$hdr->{ifdef}, $hdr->{write}],
+	      [["DEFUSE_VH"], ["DEFUSE_VAL", "DEFUSE_VH"]], "header uses, native=$native");
+    is_deeply([keys %{$uses->{tops}}], [$topname], "only top file in tops, native=$native");
+    is_deeply($uses->{tops}{$topname}{write}, ["DEFUSE_TMP", "DEFUSE_VAL", "DEFUSE_VH"],
+	      "inclusive uses, native=$native");
+}
+{
+    my (undef, $pp, $opt) = preproc($topname, define_uses=>1);
+    ok($opt->define_uses->{$topname}{value}{DEFUSE_VAL}
+       && $opt->define_uses_inclusive->{$topname}{ifdef}{DEFUSE_VH}, "merged into options");
+}
+{
+    # Names are escaped in vhier's XML
+    my $xmlname = "test_dir/31_defuse_a&b.v";
+    write_file($xmlname, "module m;\nendmodule\n`ifdef DEFUSE_XML\n`endif\n");
+    run_system("${PERL} ./vhier --xml --define-uses --nomissing '$xmlname' -o test_dir/31_defuse.xml");
+    my $xml = wholefile("test_dir/31_defuse.xml");
+    ok($xml =~ m!<file name="test_dir/31_defuse_a&amp;b\.v">! && $xml !~ /a&b/, "vhier XML escaped");
+}
@@ -0,0 +1,55 @@
+#!/usr/bin/perl -w
+# DESCRIPTION: Perl ExtUtils: Type 'make test' to test this package
+#
+# Copyright 2000-2021 by Wilson Snyder.  This program is free software;
+# you can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License Version 2.0.
+
+use strict;
+use Test::More;
+
+BEGIN { plan tests => 11 }
+BEGIN { require "./t/test_utils.pl"; }
+
+#######################################################################
+
+use Verilog::Getopt;
+use Verilog::Preproc;
+ok(1, "use");
+
+write_file("test_dir/31_inccache_top.v", "`include \"31_inccache.vh\"\ntop\n");
+write_file("test_dir/31_inccache.vh", "header_one\r\n");
+write_file("test_dir/31_inccache_copy.vh", "header_one\r\n");
+
+Verilog::Preproc::include_cache_limit(1024*1024);
+is(Verilog::Preproc::include_cache_limit(), 1024*1024, "limit");
+
+my $base = Verilog::Preproc::include_cache_stats();
+my $out1 = preproc("test_dir/31_inccache_top.v", line_directives=>0);
+like($out1, qr/header_one\s+top/, "first read");
+my $out2 = preproc("test_dir/31_inccache_top.v", line_directives=>0);
+is($out2, $out1, "cached read");
+my $stats = Verilog::Preproc::include_cache_stats();
+is($stats->{hits} - $base->{hits}, 1, "hit counted");
+is($stats->{bytes_saved} - $base->{bytes_saved}, length("header_one\n"), "bytes_saved counted");
+
+# Changed file must be read again
+sleep 1;  # Ensure new mtime
+write_file("test_dir/31_inccache.vh", "header_two\n");
+like(scalar(preproc("test_dir/31_inccache_top.v", line_directives=>0)), qr/header_two\s+top/, "changed file re-read");
+
+# Identical contents share an entry
+Verilog::Preproc::include_cache_hash(1);
+write_file("test_dir/31_inccache_twin.vh", "header_one\n");
+write_file("test_dir/31_inccache_top2.v", "`include \"31_inccache_copy.vh\"\n`include \"31_inccache_twin.vh\"\n");
+my $before = Verilog::Preproc::include_cache_stats();
+preproc("test_dir/31_inccache_top2.v", line_directives=>0);
+is(Verilog::Preproc::include_cache_stats()->{entries} - $before->{entries}, 1, "identical files share entry");
+
+# Disabled
+Verilog::Preproc::include_cache_limit(0);
+$stats = Verilog::Preproc::include_cache_stats();
+is($stats->{entries}, 0, "disabled flushes");
+(my $exp = $out2) =~ s/header_one/header_two/;
+is(scalar(preproc("test_dir/31_inccache_top.v", line_directives=>0)), $exp, "uncached read");
+is(Verilog::Preproc::include_cache_stats()->{misses}, $stats->{misses}, "uncached not counted");
@@ -0,0 +1,68 @@
+#!/usr/bin/perl -w
+# DESCRIPTION: Perl ExtUtils: Type 'make test' to test this package
+#
+# Copyright 2000-2021 by Wilson Snyder.  This program is free software;
+# you can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License Version 2.0.
+
+use strict;
+use Test::More;
+
+BEGIN { plan tests => 9 }
+BEGIN { require "./t/test_utils.pl"; }
+
+#######################################################################
+
+use Verilog::Getopt;
+use Verilog::Preproc;
+ok(1, "use");
+
+write_file("test_dir/31_incguard.vh",
+	   "// Comment outside guard\n"
+	   ."`ifndef INCGUARD_VH\n"
+	   ."`define INCGUARD_VH\n"
+	   ."guarded_text\n"
+	   ."`endif  // INCGUARD_VH\n");
+write_file("test_dir/31_incguard_not.vh",
+	   "`ifndef INCGUARD_NOT_VH\n"
+	   ."`define INCGUARD_NOT_VH\n"
+	   ."`endif\n"
+	   ."unguarded_text\n");
+write_file("test_dir/31_incguard_top.v",
+	   "`include \"31_incguard.vh\"\n"
+	   ."`include \"31_incguard.vh\"\n"
+	   ."`include \"31_incguard_not.vh\"\n"
+	   ."`include \"31_incguard_not.vh\"\n"
+	   ."`undef INCGUARD_VH\n"
+	   ."`include \"31_incguard.vh\"\n"
+	   ."`include \"31_incguard.vh\"\n");
+
+{
+    my ($out, $pp) = preproc("test_dir/31_incguard_top.v", keep_comments=>0);
+    my $stats = $pp->stats;
+    is(count($out, "guarded_text"), 2, "guarded text after undef");
+    is(count($out, "unguarded_text"), 2, "unguarded text");
+    is($stats->{include_guard_skips}, 2, "guard skips");
+}
+{
+    # Second preprocessor, with the guard already learned
+    my ($out, $pp) = preproc("test_dir/31_incguard_top.v", keep_comments=>0);
+    my $stats = $pp->stats;
+    is(count($out, "guarded_text"), 2, "guarded text, relearned");
+    is($stats->{include_guard_skips}, 2, "guard skips, relearned");
+}
+{
+    # Comment outside the guard must appear each time
+    my ($out, $pp) = preproc("test_dir/31_incguard_top.v", keep_comments=>1);
+    my $stats = $pp->stats;
+    is(count($out, "guarded_text"), 2, "guarded text with comments");
+    is(count($out, "Comment outside guard"), 4, "comments kept");
+    is($stats->{include_guard_skips}, 0, "no guard skips with comments");
+}
+
+sub count {
+    my $text = shift;
+    my $match = shift;
+    my @hits = ($text =~ /\b\Q$match\E\b/g);
+    return scalar(@hits);
+}
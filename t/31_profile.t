@@ -0,0 +1,59 @@
+#!/usr/bin/perl -w
+# DESCRIPTION: Perl ExtUtils: Type 'make test' to test this package
+#
+# Copyright 2000-2021 by Wilson Snyder.  This program is free software;
+# you can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License Version 2.0.
+
+use strict;
+use Test::More;
+
+BEGIN { plan tests => 12 }
+BEGIN { require "./t/test_utils.pl"; }
+
+#######################################################################
+
+use Verilog::Getopt;
+use Verilog::Preproc;
+ok(1, "use");
+
+write_file("test_dir/31_profile.vh",
+	   "`define PROF_SIMPLE simple_value\n"
+	   ."`define PROF_ARG(x) (x+x)\n"
+	   ."header_text\n");
+write_file("test_dir/31_profile_top.v",
+	   "`include \"31_profile.vh\"\n"
+	   ."`include \"31_profile.vh\"\n"
+	   ."`ifdef PROF_NEVER\n"
+	   ."  disabled text that is skipped\n"
+	   ."`endif\n"
+	   ."a = `PROF_SIMPLE;\n"
+	   ."b = `PROF_ARG(1) + `PROF_ARG(`PROF_SIMPLE);\n");
+
+{
+    my (undef, $pp) = preproc("test_dir/31_profile_top.v");
+    my $stats = $pp->stats;
+    ok(!exists $stats->{files}, "no profile by default");
+}
+{
+    my (undef, $pp) = preproc("test_dir/31_profile_top.v", profile=>1);
+    my $stats = $pp->stats;
+    my $top = $stats->{files}{"test_dir/31_profile_top.v"};
+    my ($hname) = grep { /31_profile\.vh$/ } keys %{$stats->{files}};
+    my $hdr = $stats->{files}{$hname||""};
+    ok($top && $hdr, "files profiled");
+    is($top->{opens}, 1, "top opens");
+    is($hdr->{opens}, 2, "header opens");
+    ok($top->{skipped_bytes} >= length("disabled text that is skipped"), "skipped bytes");
+    ok($hdr->{tokens} > 0 && $hdr->{bytes} > $hdr->{skipped_bytes}, "header tokens");
+    ok($top->{time_inclusive} >= $hdr->{time_inclusive}
+       && $top->{time_inclusive} >= $top->{time_exclusive}, "inclusive time");
+    is($stats->{defines}{PROF_SIMPLE}{count}, 3, "simple define count");  # Once per use of x
+    is($stats->{defines}{PROF_SIMPLE}{bytes}, 3*length("simple_value"), "simple define bytes");
+    is($stats->{defines}{PROF_ARG}{count}, 2, "define with arguments count");
+}
+{
+    my $out = `${main::PERL} ./vppreproc --profile +incdir+test_dir test_dir/31_profile_top.v 2>&1 >/dev/null`;
+    like($out, qr/profile by file:.*31_profile_top\.v.*profile by define:.*`PROF_SIMPLE/s,
+	 "vppreproc --profile");
+}
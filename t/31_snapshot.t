@@ -0,0 +1,55 @@
+#!/usr/bin/perl -w
+# DESCRIPTION: Perl ExtUtils: Type 'make test' to test this package
+#
+# Copyright 2000-2021 by Wilson Snyder.  This program is free software;
+# you can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License Version 2.0.
+
+use strict;
+use Test::More;
+
+BEGIN { plan tests => 8 }
+BEGIN { require "./t/test_utils.pl"; }
+
+#######################################################################
+
+use Verilog::Getopt;
+use Verilog::Preproc;
+ok(1, "use");
+
+my $snap = "test_dir/31_snapshot.snap";
+write_file("test_dir/31_snapshot_pre.vh",
+	   "`ifndef _SNAPSHOT_PRE_VH_\n`define _SNAPSHOT_PRE_VH_\n`define GLOBAL_W 32\n`endif\n");
+write_file("test_dir/31_snapshot_top.v",
+	   "`include \"31_snapshot_pre.vh\"\nwire [`GLOBAL_W-1:0] w;\n");
+
+{
+    my $pp = new_pp();
+    $pp->open("test_dir/31_snapshot_pre.vh");
+    while (defined($pp->getline())) {}
+    $pp->snapshot_save($snap);
+    ok(-r $snap, "saved");
+}
+
+{
+    my $pp = new_pp();
+    ok($pp->snapshot_restore($snap), "restored");
+    is($pp->def_value("GLOBAL_W"), "32", "restored define");
+    $pp->open("test_dir/31_snapshot_top.v");
+    my $out = "";
+    while (defined(my $line = $pp->getline())) { $out .= $line; }
+    like($out, qr/wire \[32-1:0\] w;/, "restored output");
+    is($pp->stats->{include_guard_skips}, 1, "restored guard");
+}
+
+ok(!new_pp("+define+OTHER")->snapshot_restore($snap), "command line define differs");
+
+write_file("test_dir/31_snapshot_pre.vh",
+	   "`ifndef _SNAPSHOT_PRE_VH_\n`define _SNAPSHOT_PRE_VH_\n`define GLOBAL_W 128\n`endif\n");
+ok(!new_pp()->snapshot_restore($snap), "changed file");
+
+sub new_pp {
+    my $opt = new Verilog::Getopt;
+    $opt->parameter("+incdir+test_dir", @_);
+    return Verilog::Preproc->new(options=>$opt, native_defines=>1, line_directives=>0);
+}
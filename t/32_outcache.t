@@ -0,0 +1,86 @@
+#!/usr/bin/perl -w
+# DESCRIPTION: Perl ExtUtils: Type 'make test' to test this package
+#
+# Copyright 2000-2021 by Wilson Snyder.  This program is free software;
+# you can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License Version 2.0.
+
+use File::Find;
+use File::Path;
+use strict;
+use Test::More;
+
+BEGIN { plan tests => 13 }
+BEGIN { require "./t/test_utils.pl"; }
+
+#######################################################################
+
+use Verilog::Getopt;
+use Verilog::Preproc;
+ok(1, "use");
+
+my $cache_dir = "test_dir/32_outcache";
+rmtree($cache_dir);
+rmtree("test_dir/32_outcache_first");
+
+write_file("test_dir/32_outcache_top.v",
+	   "`include \"32_outcache.vh\"\n"
+	   ."`ifdef USE_B\n b_path `VAL\n`else\n a_path `VAL\n`endif\n"
+	   ."`define SET_BY_TOP 5\n");
+write_file("test_dir/32_outcache.vh", "`define VAL val_one\n");
+
+my ($ref_out, $ref_defs) = cached_preproc();
+like($ref_out, qr/a_path val_one/, "uncached");
+
+my ($out, $defs, $pp) = cached_preproc(cache_dir=>$cache_dir);
+is($out, $ref_out, "first read");
+ok(!$pp->{_cache_hits}, "first read missed");
+
+($out, $defs, $pp) = cached_preproc(cache_dir=>$cache_dir);
+is($out, $ref_out, "cached read");
+is($pp->{_cache_hits}, 1, "cached read hit");
+is($defs, $ref_defs, "cached read defines");
+
+# Consulted define changed
+($out, $defs, $pp) = cached_preproc(cache_dir=>$cache_dir, define=>"USE_B");
+like($out, qr/b_path val_one/, "define change missed");
+
+# Included file changed
+write_file("test_dir/32_outcache.vh", "`define VAL val_two\n");
+($out, $defs, $pp) = cached_preproc(cache_dir=>$cache_dir);
+like($out, qr/a_path val_two/, "include change missed");
+
+# Include found earlier in the search path
+mkpath("test_dir/32_outcache_first");
+write_file("test_dir/32_outcache_first/32_outcache.vh", "`define VAL val_first\n");
+($out, $defs, $pp) = cached_preproc(cache_dir=>$cache_dir);
+like($out, qr/a_path val_first/, "include path change missed");
+
+# Size index matches the files
+my $size = 0;
+File::Find::find({no_chdir=>1, wanted=>sub { $size += -s $_ if -f $_ && $_ ne "$cache_dir/size"; }}, $cache_dir);
+is(wholefile("$cache_dir/size"), "$size\n", "size index");
+
+# Over the size limit
+rmtree($cache_dir);
+cached_preproc(cache_dir=>$cache_dir, cache_size=>1);
+my @left;
+File::Find::find({no_chdir=>1, wanted=>sub { push @left, $_ if -f $_ && $_ ne "$cache_dir/size"; }}, $cache_dir);
+is($#left, -1, "trimmed to cache_size");
+is(wholefile("$cache_dir/size"), "0\n", "size index trimmed");
+
+sub cached_preproc {
+    my %params = @_;
+    my $opt = new Verilog::Getopt;
+    $opt->incdir("test_dir/32_outcache_first");
+    $opt->incdir("test_dir");
+    $opt->define($params{define}, 1, undef, 1) if $params{define};
+    delete $params{define};
+    my ($out, $pp) = preproc("test_dir/32_outcache_top.v",
+			     options=>$opt, native_defines=>1, %params);
+    my $defs = "";
+    foreach my $name ($opt->define_names_sorted) {
+	$defs .= sprintf("%s %s\n", $name, $opt->defvalue($name));
+    }
+    return ($out, $defs, $pp);
+}
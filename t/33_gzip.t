@@ -8,8 +8,9 @@
 use IO::File;
 use strict;
 use Test::More;
+use Time::HiRes qw(gettimeofday tv_interval);
 
-BEGIN { plan tests => 4 }
+BEGIN { plan tests => 13 }
 BEGIN { require "./t/test_utils.pl"; }
 
 #######################################################################
@@ -18,25 +19,84 @@ use Verilog::Getopt;
 use Verilog::Preproc;
 ok(1, "use");
 
-# Check we get error
+# Each codec, by the program that creates test files and the extension
+codec_test("gzip", "gz");
+codec_test("zstd", "zst");
+codec_test("xz", "xz");
+
+# Compression is found by magic number, not the filename
+SKIP: {
+    if (`which gzip` !~ m!^/!) {
+	skip("no gzip installed (harmless)",2);
+    }
+    system("gzip t/32_noinc.v -c > test_dir/33_gzip_misnamed.v");
+    ok (-r "test_dir/33_gzip_misnamed.v", "gzip misnamed creation");
+    ok (found_text("test_dir/33_gzip_misnamed.v"), "decompress misnamed found text");
+}
+
+# Many small compressed files, as with cell libraries
 SKIP: {
     if (`which gzip` !~ m!^/!
 	|| `which gunzip` !~ m!^/!) {
-	skip("no gzip installed (harmless)",3);
+	skip("no gzip installed (harmless)",1);
+    }
+    my $count = 200;
+    my @files;
+    for (my $i=0; $i<$count; $i++) {
+	my $fn = "test_dir/33_gzip_cell_$i.v";
+	my $fh = IO::File->new(">$fn") or die "%Error: $! $fn,";
+	print $fh "module cell_$i (input a, output z);\n";
+	print $fh "  assign z = ~a;  // text\n" for (1..50);
+	print $fh "endmodule\n";
+	$fh->close;
+	system("gzip -f $fn");
+	push @files, "$fn.gz";
     }
-    system("gzip t/32_noinc.v -c > test_dir/33_gzip.v.gz");
-    ok (-r "test_dir/33_gzip.v.gz", "gzip test creation");
 
+    # Compare with what reading through the gunzip program costs: a
+    # gunzip run per file, then preprocessing its output
+    my $t0 = [gettimeofday];
+    my $hits = 0;
+    $hits++ for grep { found_text($_) } @files;
+    my $t1 = [gettimeofday];
+    my $plain = "test_dir/33_gzip_cell.v";
+    foreach my $fn (@files) {
+	system("gunzip -c $fn > $plain");
+	found_text($plain);
+    }
+    my $t2 = [gettimeofday];
+    printf "For $count gzip files: preprocess %1.3f s, with gunzip programs %1.3f s\n",
+	tv_interval($t0,$t1), tv_interval($t1,$t2);
+    is ($hits, $count, "decompress many files");
+    unlink(@files);
+}
+
+sub codec_test {
+    my $prog = shift;
+    my $ext = shift;
+  SKIP: {
+      if (`which $prog` !~ m!^/!) {
+	  skip("no $prog installed (harmless)",3);
+      }
+      my $filename = "test_dir/33_gzip.v.$ext";
+      unlink $filename;
+      system("$prog -c t/32_noinc.v > $filename");
+      ok (-r $filename, "$prog test creation");
+      ok (-s $filename, "$prog test creation size");
+      ok (found_text($filename), "$prog decompress found text");
+    }
+}
+
+sub found_text {
+    my $filename = shift;
     my $opt = new Verilog::Getopt;
     my $pp = new Verilog::Preproc (options=>$opt,
 				   include_open_nonfatal=>1,);
-    $pp->open("test_dir/33_gzip.v.gz");
-    ok(1, "open");
-
+    $pp->open($filename);
     my $hit;
     while (defined(my $line = $pp->getline())) {
 	#print "TEXT $line";
 	$hit = 1 if $line =~ /text/;
     }
-    ok ($hit, "decompress found text");
+    return $hit;
 }
@@ -9,7 +9,7 @@ use strict;
 use Test::More;
 use Data::Dumper; $Data::Dumper::Indent = 1; #Debug
 
-BEGIN { plan tests => 7 }
+BEGIN { plan tests => 19 }
 BEGIN { require "./t/test_utils.pl"; }
 
 our %_TestCoverage;
@@ -54,8 +54,35 @@ sub _common {
 
 ######################################################################
 
+package MyTextParser;
+use base qw(MyParser);
+
+# Overriding parse forces text to go through Perl
+sub parse { my $self = shift; $self->SUPER::parse(@_); }
+
+######################################################################
+
+package MyLineParser;
+use base qw(Verilog::Parser);
+
+# Location of each token, to compare with and without line_map
+sub keyword { $_[0]->_line($_[1]); }
+sub symbol { $_[0]->_line($_[1]); }
+sub preproc { $_[0]->SUPER::preproc($_[1]) if $_[1] !~ /^`line/; }  # line_map doesn't lex these
+sub _line { my $self = shift; push @{$self->{lines}}, $self->filename.":".$self->lineno." ".$_[0]; }
+
+######################################################################
+
+package MyDiePreproc;
+use base qw(Verilog::Preproc);
+
+sub comment { die "%Error: MyDiePreproc comment\n"; }
+
+######################################################################
+
 package main;
 
+use Verilog::Getopt;
 use Verilog::Parser;
 use Verilog::Preproc;
 ok(1, "use");
@@ -81,6 +108,96 @@ $dump_fh->close();
 # Did we read the right stuff?
 ok(files_identical("test_dir/34.dmp", "t/34_parser.out"), "diff");
 
+# Same result with text passed through Perl
+{
+    my $text_fh = new IO::File(">test_dir/34_text.dmp") or die "%Error: $! test_dir/34_text.dmp,";
+    my $pp = Verilog::Preproc->new();
+    ok(!MyTextParser->new->_parse_preproc_direct_ok($pp), "parse override disables direct");
+    read_test("verilog/v_hier_subprim.v", $text_fh, "MyTextParser");
+    read_test("verilog/v_hier_sub.v", $text_fh, "MyTextParser");
+    read_test("verilog/example.v", $text_fh, "MyTextParser");
+    $text_fh->close();
+    ok(files_identical("test_dir/34_text.dmp", "t/34_parser.out"), "diff text mode");
+
+    my $p = Verilog::Parser->new;
+    $p->parse(wholefile("verilog/example.v"));
+    $p->eof;
+    my $stats = $p->stats;
+    ok($stats->{bytes} > 1000 && $stats->{copied_bytes} <= $stats->{bytes}, "text copied at most once");
+}
+
+# Same result preprocessing on a separate thread
+{
+    my $pipe_fh = new IO::File(">test_dir/34_pipe.dmp") or die "%Error: $! test_dir/34_pipe.dmp,";
+    read_test("verilog/v_hier_subprim.v", $pipe_fh, "MyParser", pipeline=>1);
+    read_test("verilog/v_hier_sub.v", $pipe_fh, "MyParser", pipeline=>1);
+    read_test("verilog/example.v", $pipe_fh, "MyParser", pipeline=>1);
+    $pipe_fh->close();
+    ok(files_identical("test_dir/34_pipe.dmp", "t/34_parser.out"), "diff pipeline");
+
+    my $pp = MyDiePreproc->new(keep_comments=>'sub', pipeline=>1);
+    $pp->open("verilog/example.v");
+    my $parser = MyLineParser->new;
+    eval { $parser->parse_preproc_file($pp); };
+    like($@, qr/MyDiePreproc comment/, "pipeline callback die");
+    # The preprocessor is gone, so must not be read again
+    undef $pp;
+    $parser->{lines} = [];
+    $parser->parse("module after_die;\nendmodule\n");
+    $parser->eof;
+    like(join(" ", @{$parser->{lines}}), qr/after_die/, "parse after pipeline die");
+}
+
+# Same result parsing each line as it arrives
+{
+    my $inc_fh = new IO::File(">test_dir/34_inc.dmp") or die "%Error: $! test_dir/34_inc.dmp,";
+    foreach my $filename ("verilog/v_hier_subprim.v", "verilog/v_hier_sub.v", "verilog/example.v") {
+	my $pp = Verilog::Preproc->new(keep_comments=>0);
+	my $parser = MyParser->new(dump_fh => $inc_fh, incremental => 1);
+	$pp->open($filename);
+	while (defined(my $line = $pp->getline)) {
+	    $parser->parse($line);
+	}
+	$parser->eof;
+    }
+    $inc_fh->close();
+    ok(files_identical("test_dir/34_inc.dmp", "t/34_parser.out"), "diff incremental");
+
+    my $parser = MyLineParser->new(incremental => 1);
+    $parser->filename("inc.v");
+    $parser->lineno(1);
+    $parser->parse("module inc;\n  wire /* open\n");
+    my $early = join(" ", @{$parser->{lines}});
+    $parser->parse("  */ w;\nendmodule\n");
+    $parser->eof;
+    is($early, "inc.v:1 module inc.v:1 inc", "incremental callbacks before eof");
+}
+
+# Same locations with line_map, across includes and `line
+{
+    my $ref = line_test();
+    my $got = line_test(line_map=>1);
+    ok($#$ref > 10 && join("\n",@$got) eq join("\n",@$ref), "line_map locations");
+    $got = line_test(line_map=>1, pipeline=>1);
+    ok(join("\n",@$got) eq join("\n",@$ref), "line_map pipeline locations");
+}
+
+# Symbols shared by parsers given one symbol_table, seen as [type, parent, {}]
+# The grammar, so SigParser, is what declares them
+{
+    require Verilog::SigParser;
+    my $st = [];
+    my $p1 = Verilog::SigParser->new(symbol_table => $st);
+    $p1->parse("package p34; typedef int t34; endpackage\n");
+    $p1->eof;
+    my $p2 = Verilog::SigParser->new(symbol_table => $st);
+    $p2->parse("module m34; import p34::*; endmodule\n");
+    $p2->eof;
+    my $tab = $p2->symbol_table;
+    ok($tab == $st && $tab->[2]{p34}[2]{t34}[1] == $tab->[2]{p34}, "symbol_table shape");
+    ok($tab->[2]{m34}[2]{t34} == $tab->[2]{p34}[2]{t34}, "symbol_table import shared");
+}
+
 # Did we cover everything?
 my $err;
 foreach my $cb (Verilog::Parser::callback_names()) {
@@ -96,12 +213,29 @@ ok (!$err, "coverage");
 sub read_test {
     my $filename = shift;
     my $dump_fh = shift;
+    my $class = shift || "MyParser";
+    my @ppopts = @_;
 
-    my $pp = Verilog::Preproc->new(keep_comments=>0,);
+    my $pp = Verilog::Preproc->new(keep_comments=>0, @ppopts);
 
-    my $parser = new MyParser (dump_fh => $dump_fh);
+    my $parser = $class->new(dump_fh => $dump_fh);
 
     # Preprocess
     $pp->open($filename);
     $parser->parse_preproc_file($pp);
 }
+
+sub line_test {
+    my @ppopts = @_;
+    my @lines;
+    foreach my $filename ("verilog/v_hier_top.v", "verilog/v_sv_mod.v", "verilog/inc2.v") {
+	my $opt = Verilog::Getopt->new;
+	$opt->incdir("verilog");
+	my $pp = Verilog::Preproc->new(keep_comments=>0, options=>$opt, @ppopts);
+	my $parser = MyLineParser->new;
+	$pp->open($filename);
+	$parser->parse_preproc_file($pp);
+	push @lines, @{$parser->{lines}};
+    }
+    return \@lines;
+}
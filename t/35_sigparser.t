@@ -9,7 +9,7 @@ use strict;
 use Test::More;
 use Data::Dumper; $Data::Dumper::Indent = 1;
 
-BEGIN { plan tests => 6 }
+BEGIN { plan tests => 8 }
 BEGIN { require "./t/test_utils.pl"; }
 
 our %_TestCoverage;
@@ -92,6 +92,12 @@ ok(1, "read-pinselects");
 # Did we read the right stuff?
 ok(files_identical("test_dir/35_ps.dmp", "t/35_sigparser_ps.out"), "diff");
 
+read_tests("test_dir/35_inc.dmp",
+	   [incremental => 1]);
+ok(1, "read-incremental");
+# Same as when parsed after the whole file
+ok(files_identical("test_dir/35_inc.dmp", "t/35_sigparser.out"), "diff");
+
 # Did we cover everything?
 my $err;
 foreach my $cb (sort keys %_TestCallbacks) {
@@ -141,7 +147,16 @@ sub read_test {
 
     # Preprocess
     $pp->open($filename);
-    $parser->parse_preproc_file($pp);
+    if ($parser->{incremental}) {
+	# Each line is parsed as it arrives
+	$parser->reset;  # As parse_preproc_file does, to include std::
+	while (defined(my $line = $pp->getline)) {
+	    $parser->parse($line);
+	}
+	$parser->eof;
+    } else {
+	$parser->parse_preproc_file($pp);
+    }
 
-    print Dumper($parser->{symbol_table}) if ($parser->debug());
+    print Dumper($parser->symbol_table) if ($parser->debug());
 }
@@ -144,7 +144,7 @@ sub one_parse {
 	$::Any_Error = 1;
     }
 
-    print Dumper($parser->{symbol_table}) if $parser->debug;
+    print Dumper($parser->symbol_table) if $parser->debug;
 
     return $parser;
 }
@@ -0,0 +1,139 @@
+#!/usr/bin/perl -w
+# DESCRIPTION: Perl ExtUtils: Type 'make test' to test this package
+#
+# Copyright 2000-2021 by Wilson Snyder.  This program is free software;
+# you can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License Version 2.0.
+
+use Config;
+use strict;
+use Test::More;
+
+our @Files = qw(verilog/v_hier_top.v verilog/parser_sv.v
+		verilog/parser_bugs.v verilog/v_comments.v);
+
+BEGIN { plan tests => 1+2+4+3+1 }
+BEGIN { require "./t/test_utils.pl"; }
+
+######################################################################
+
+package MyParser;
+use Verilog::Parser;
+use strict;
+use base qw(Verilog::Parser);
+
+BEGIN {
+    foreach my $cb (Verilog::Parser::callback_names()) {
+	my $func = ' sub __CB__ { $_[0]->_common("__CB__", @_); } ';
+	$func =~ s/__CB__/$cb/g;
+	eval($func);
+    }
+}
+
+sub error { $_[0]->_common("error", @_); }
+
+sub _common {
+    my $self = shift;
+    my $what = shift;
+    my $call_self = shift;
+    my $args = "";
+    foreach (@_) { $args .= defined $_ ? " '$_'" : " undef"; }
+    $self->{dump} .= sprintf("%s:%03d: %s%s\n",
+			     $self->filename, $self->lineno, uc $what, $args);
+}
+
+######################################################################
+
+package main;
+
+use Verilog::Getopt;
+use Verilog::Preproc;
+ok(1, "use");
+
+{
+    # Two parsers active at once, each lexing its lines as they arrive
+    my @texts = map { wholefile($_) } @Files[0..1];
+    my @serial = map { parse_text($_) } @texts;
+
+    my @parsers = map { MyParser->new(incremental => 1) } @texts;
+    my @lines = map { [split /(?<=\n)/, $_] } @texts;
+    while (@{$lines[0]} || @{$lines[1]}) {
+	foreach my $i (0..1) {
+	    $parsers[$i]->parse(shift @{$lines[$i]}) if @{$lines[$i]};
+	}
+    }
+    foreach my $i (0..1) {
+	$parsers[$i]->eof;
+	is($parsers[$i]->{dump}, $serial[$i], "interleaved $Files[$i]");
+    }
+}
+
+SKIP: {
+    skip("perl built without threads", 4) if !$Config{useithreads};
+    require threads;
+    # Parsers must not exist when threads are created, or they would be cloned
+    my @thr = map { my $f = $_; threads->create(sub { parse_preproc($f) }) } @Files;
+    my @threaded = map { $_->join } @thr;
+    foreach my $i (0..$#Files) {
+	is($threaded[$i], parse_preproc($Files[$i]), "threaded $Files[$i]");
+    }
+}
+
+{
+    # Files read ahead must see the defines of the files before them
+    write_file("test_dir/37_def.v", "`define T37_DEF def_used\n"
+	       ."module t37_def; endmodule\n");
+    write_file("test_dir/37_use.v", "`ifdef T37_DEF module `T37_DEF; endmodule\n"
+	       ."`else module def_unused; endmodule `endif\n");
+    my @files = ("test_dir/37_def.v", "test_dir/37_use.v", @Files);
+    my @dumps;
+    foreach my $threads (1, 3) {
+	my $opt = new Verilog::Getopt;
+	$opt->incdir("verilog");
+	my $parser = MyParser->new;
+	$parser->parse_files(\@files, threads=>$threads, options=>$opt, keep_comments=>0);
+	push @dumps, $parser->{dump};
+    }
+    like($dumps[1], qr/'def_used'/, "parse_files define from earlier file");
+    unlike($dumps[1], qr/'def_unused'/, "parse_files ifdef from earlier file");
+    is($dumps[1], $dumps[0], "parse_files threads=>3");
+}
+
+{
+    require Verilog::Netlist;
+    my @files = qw(verilog/v_hier_top.v verilog/v_hier_top2.v verilog/v_comments.v);
+    my @texts;
+    foreach my $threads (0, 3) {
+	my $opt = new Verilog::Getopt;
+	$opt->parameter("+incdir+verilog", "-y", "verilog");
+	my $nl = new Verilog::Netlist(options=>$opt, link_read_nonfatal=>1,
+				      keep_comments=>1);
+	if ($threads) {
+	    $nl->read_files(filenames=>\@files, threads=>$threads);
+	} else {
+	    $nl->read_file(filename=>$_) foreach @files;
+	}
+	$nl->link;
+	push @texts, scalar($nl->verilog_text);
+    }
+    is($texts[1], $texts[0], "netlist read_files threads=>3");
+}
+
+sub parse_text {
+    my $text = shift;
+    my $parser = MyParser->new;
+    $parser->parse($text);
+    $parser->eof;
+    return $parser->{dump};
+}
+
+sub parse_preproc {
+    my $filename = shift;
+    my $opt = new Verilog::Getopt;
+    $opt->incdir("verilog");
+    my $pp = new Verilog::Preproc(options=>$opt, keep_comments=>0);
+    $pp->open($filename);
+    my $parser = MyParser->new;
+    $parser->parse_preproc_file($pp);
+    return $parser->{dump};
+}
@@ -10,7 +10,7 @@ use Test::More;
 use Time::HiRes qw(gettimeofday tv_interval);
 use Data::Dumper; $Data::Dumper::Indent = 1;
 
-BEGIN { plan tests => 4 }
+BEGIN { plan tests => 12 }
 BEGIN { require "./t/test_utils.pl"; }
 
 use Verilog::SigParser;
@@ -32,6 +32,10 @@ prep("${Opt_Dir}/largeish_3.v",1+$nets);
 
 per_net_test('sigparser', 100000);
 per_net_test('netlist', 100000);
+ifdef_skip_test("${Opt_Dir}/largeish_off.v", $nets*10);
+long_line_test("${Opt_Dir}/largeish_line", $nets*2);
+streaming_test("${Opt_Dir}/largeish_stream.v", $nets*100);
+prepass_test("${Opt_Dir}/largeish_dos.v", $nets);
 
 unlink(glob("${Opt_Dir}/largeish_*"));   # Fat, so don't keep around
 
@@ -100,6 +104,159 @@ sub per_net_test {
     }
 }
 
+sub ifdef_skip_test {
+    my $filename = shift;
+    my $count = shift;
+
+    my $fh = IO::File->new(">$filename");
+    print $fh "`ifdef LARGEISH_NEVER\n";
+    for (my $i=0; $i<$count; $i++) {
+	printf $fh " wire [`W-1:0] n%0".($Opt_Sym_Size-1)."d = \"str\"; // cmt\n", $i;
+	print $fh "  `ifdef NESTED\n\t\tassign n${i}``x = 1/2; /* cmt */\n  `endif\n" if ($i%100)==0;
+    }
+    print $fh "`endif\n";
+    print $fh "after_off\n";
+    $fh->close;
+    my $lines = 3 + $count + 3*int(($count+99)/100);  # Line of after_off
+
+    my $pp = Verilog::Preproc->new(keep_comments=>0, line_directives=>0);
+    my $t0 = [gettimeofday];
+    $pp->open($filename);
+    my $out = "";
+    while (defined(my $text = $pp->getall)) { $out .= $text; }
+    my $deltatime = tv_interval($t0, [gettimeofday]);
+    my $skipped = $pp->stats->{ifdef_skip_bytes};
+    printf "For ifdef skip $filename: File %1.3f MB, %1.3f s, Skipped %1.3f MB, %1.1f MB/s\n"
+	, (-s $filename)/1024/1024, $deltatime, $skipped/1024/1024
+	, (-s $filename)/1024/1024/($deltatime||1e-6);
+
+    ok($skipped > (-s $filename)/2, "ifdef skip bytes");
+    my ($before) = ($out =~ /^(.*?)after_off/s);
+    my $line = 1 + (($before||"") =~ tr/\n//);
+    $out =~ s/\s+//g;
+    is("$out:$line", "after_off:$lines", "ifdef skip text and lines");
+}
+
+sub long_line_test {
+    my $basename = shift;
+    my $count = shift;
+    # One logical line, as in generated netlists, must still be linear
+
+    my @secPerB;
+    my $ok = 1;
+    foreach my $mult (1, 10) {
+	my $filename = "${basename}_${mult}.v";
+	my $fh = IO::File->new(">$filename");
+	print $fh "assign x = ", ("n + " x ($count*$mult)), "n;\nnext_line\n";
+	$fh->close;
+	my $t0 = [gettimeofday];
+	my $pp = Verilog::Preproc->new(keep_comments=>0, line_directives=>0);
+	$pp->open($filename);
+	my @lines;
+	while (defined(my $line = $pp->getline)) { push @lines, $line; }
+	my $deltatime = tv_interval($t0, [gettimeofday]);
+	pop @lines if $#lines == 2 && $lines[2] eq "\n";  # From the `line at EOF
+	$ok = 0 if $#lines != 1 || $lines[1] ne "next_line\n";
+	$secPerB[$mult] = $deltatime / ((-s $filename)/1024/1024);
+	printf "For long line $filename: File %1.3f MB, %1.3f s, %1.1f s/MB\n"
+	    , (-s $filename)/1024/1024, $deltatime, $secPerB[$mult];
+    }
+    ok($ok, "long line getline");
+
+    my $slope = $secPerB[10] / ($secPerB[1]||1);
+  SKIP: {
+      if ($slope < 2) {
+	  ok(1, "long line complexity");
+      } else {
+	  if (!$ENV{VERILATOR_AUTHOR_SITE} || $ENV{HARNESS_FAST}) {
+	      skip("waived, author only test",1);
+	  } else {
+	      warn "%Warning: ",$slope," non O(n) based on line length, slope=$slope\n";
+	      ok(0, "long line complexity");
+	  }
+	}
+    }
+}
+
+sub prepass_test {
+    my $filename = shift;
+    my $count = shift;
+    # CR and NUL stripping is done a vector at a time, so vary the alignment
+
+    my $unix = "";
+    my $dos = "";
+    for (my $i=0; $i<$count; $i++) {
+	my $line = " wire n".("x" x ($i%67)).";";
+	$unix .= "$line\n";
+	$dos .= (($i%5)==0 ? "$line\0\r\r\n" : "$line\r\n");
+    }
+    my $fh = IO::File->new(">$filename");
+    binmode $fh;
+    print $fh $dos;
+    $fh->close;
+
+    my $pp = Verilog::Preproc->new(keep_comments=>0, line_directives=>0);
+    $pp->open($filename);
+    my $out = "";
+    while (defined(my $text = $pp->getall)) { $out .= $text; }
+    is($out, "$unix\n", "CR and NUL stripped");  # Last newline from the `line at EOF
+
+    # Same result as a character at a time, with runs of every length
+    my $mixed = "";
+    for (my $i=0; $i<2000; $i++) {
+	my $run = ($i*$i) % 41;
+	$mixed .= ("x" x ($i%37)).(($i%3) ? "\r" x $run : "\0\r" x ($run/2))."\n";
+    }
+    my $same = 1;
+    for (my $off=0; $off<64; $off++) {
+	my $text = substr($mixed, $off);
+	$same = 0 if (Verilog::Preproc::_prepass_strip($text, 0)
+		      ne Verilog::Preproc::_prepass_strip($text, 1));
+    }
+    ok($same, "pre-pass matches bytewise");
+
+    my $bytes = 64*1024*1024;
+    my $rate = Verilog::Preproc::_prepass_rate($bytes);
+    printf "For input pre-pass: %1.3f MB, %1.2f GB/s\n", $bytes/1024/1024, $rate/1e9;
+}
+
+sub streaming_test {
+    my $filename = shift;
+    my $count = shift;
+    # Memory must not grow with the size of the file being preprocessed
+
+    my $fh = IO::File->new(">$filename");
+    my $wirefmt = " wire n%0".($Opt_Sym_Size-1)."d;  // comment\n";
+    for (my $i=0; $i<$count; $i++) {
+	printf $fh $wirefmt, $i;
+    }
+    print $fh "last_line\n";
+    $fh->close;
+
+    my $pp = Verilog::Preproc->new(keep_comments=>0, line_directives=>0);
+    $pp->open($filename);
+    my $rss0 = get_rss_usage();
+    my $rssmax = $rss0;
+    my $nchunk = 0;
+    my $last = "";
+    while (defined(my $text = $pp->getall(64*1024))) {
+	$last = $text;
+	if ((++$nchunk % 16) == 0) {
+	    my $rss = get_rss_usage();
+	    $rssmax = $rss if $rss > $rssmax;
+	}
+    }
+    my $grew = $rssmax - $rss0;
+    printf "For streaming $filename: File %1.3f MB, RSS %1.3f MB, Grew %1.3f MB\n"
+	, (-s $filename)/1024/1024, $rss0/1024/1024, $grew/1024/1024;
+
+    like($last, qr/last_line\n$/, "streaming output");
+  SKIP: {
+      skip("no /proc/self/statm",1) if !$rss0;
+      ok($grew < 24*1024*1024, "streaming memory bounded");
+    }
+}
+
 sub read_test {
     my $pack = shift;
     my $filename = shift;
@@ -48,6 +48,34 @@ sub wholefile {
     return $wholefile;
 }
 
+sub write_file {
+    my $filename = shift;
+    my $fh = IO::File->new(">$filename") or die "%Error: $! $filename,";
+    print $fh @_;
+    $fh->close();
+}
+
+sub preproc {
+    # Preprocess a file, searching test_dir for includes unless given options.
+    # Return the text, or in list context the text, preprocessor and options.
+    my $filename = shift;
+    my %params = @_;
+    require Verilog::Getopt;
+    require Verilog::Preproc;
+    my $opt = $params{options};
+    if (!$opt) {
+	$opt = Verilog::Getopt->new;
+	$opt->incdir("test_dir");
+    }
+    my $pp = Verilog::Preproc->new(@_, options=>$opt);
+    $pp->open($filename);
+    my $out = "";
+    while (defined(my $line = $pp->getline())) {
+	$out .= $line;
+    }
+    return wantarray ? ($out, $pp, $opt) : $out;
+}
+
 sub files_identical {
     my $fn1 = shift;	# got
     my $fn2 = shift;	# expected
@@ -86,4 +114,14 @@ sub get_memory_usage {
     return ($stats[0]||0)*4096;  # vmsize
 }
 
+sub get_rss_usage {
+    # Return resident memory.  Return 0 if the system doesn't look quite right.
+    my $fh = IO::File->new("</proc/self/statm");
+    return 0 if !$fh;
+
+    my $stat = $fh->getline || "";
+    my @stats = split /\s+/, $stat;
+    return ($stats[1]||0)*4096;  # rss
+}
+
 1;
@@ -0,0 +1,3 @@
+`line 1 "verilog/inc_nonl.v" 0
+// The lack of a newline on the next line is intentional
+blah-no-newline-here>
\ No newline at end of file
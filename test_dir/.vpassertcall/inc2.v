@@ -0,0 +1,7 @@
+`line 1 "verilog/inc2.v" 0
+// DESCRIPTION: Verilog::Preproc: Example source code
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2000-2012 by Wilson Snyder.
+At file `__FILE__  line `__LINE__
+`include <t_preproc_inc3.vh>
+  
\ No newline at end of file
@@ -0,0 +1,10 @@
+`line 1 "verilog/parser_sv17.v" 0
+// 1800-2017
+module sv17;
+   integer i;
+   initial begin
+      for (i=0;;) break;
+      for (;i!=0;) begin end
+      for (;;++i) break;
+   end
+endmodule
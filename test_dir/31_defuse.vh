@@ -0,0 +1,4 @@
+`ifndef DEFUSE_VH
+`define DEFUSE_VH
+`define DEFUSE_VAL val
+`endif
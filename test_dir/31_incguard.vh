@@ -0,0 +1,5 @@
+// Comment outside guard
+`ifndef INCGUARD_VH
+`define INCGUARD_VH
+guarded_text
+`endif  // INCGUARD_VH
@@ -0,0 +1,4 @@
+`ifndef INCGUARD_NOT_VH
+`define INCGUARD_NOT_VH
+`endif
+unguarded_text
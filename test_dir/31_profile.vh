@@ -0,0 +1,3 @@
+`define PROF_SIMPLE simple_value
+`define PROF_ARG(x) (x+x)
+header_text
@@ -0,0 +1,4 @@
+`ifndef _SNAPSHOT_PRE_VH_
+`define _SNAPSHOT_PRE_VH_
+`define GLOBAL_W 128
+`endif
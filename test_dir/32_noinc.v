@@ -0,0 +1,9 @@
+// Created by vsplitmodule from 32_noinc.v
+// DESCRIPTION: Verilog::Preproc: Example source code
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2007-2012 by Wilson Snyder.
+
+text.
+
+`include "notfound"
+
@@ -0,0 +1 @@
+`define VAL val_first
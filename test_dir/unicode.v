@@ -0,0 +1,8 @@
+﻿// Bom
+module t;
+   // Chinese 评论
+   initial begin
+      $write("Hello 世界\n");
+      $write("*-* All Finished *-*\n");
+   end
+endmodule
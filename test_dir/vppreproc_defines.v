@@ -0,0 +1,17 @@
+`define SV_COV_ASSERTION 20
+`define SV_COV_CHECK 3
+`define SV_COV_ERROR -1
+`define SV_COV_FSM_STATE 21
+`define SV_COV_HIER 11
+`define SV_COV_MODULE 10
+`define SV_COV_NOCOV 0
+`define SV_COV_OK 1
+`define SV_COV_OVERFLOW -2
+`define SV_COV_PARTIAL 2
+`define SV_COV_RESET 2
+`define SV_COV_START 0
+`define SV_COV_STATEMENT 22
+`define SV_COV_STOP 1
+`define SV_COV_TOGGLE 23
+`define _EMPTY 
+`define _EXAMPLE_INC2_V_ 1
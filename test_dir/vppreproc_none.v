@@ -0,0 +1,31 @@
+`line 1 "verilog/inc2.v" 1
+// DESCRIPTION: Verilog::Preproc: Example source code
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2000-2012 by Wilson Snyder.
+At file "verilog/inc2.v"  line 4
+ 
+`line 5 "verilog/inc2.v" 0
+`line 1 "verilog/t_preproc_inc3.vh" 1
+`line 2 "inc3_a_filename_from_line_directive" 0
+// DESCRIPTION: Verilog::Preproc: Example source code
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2000-2012 by Wilson Snyder.
+
+ 
+  
+  
+  // FOO
+  At file "inc3_a_filename_from_line_directive"  line 10
+
+   
+ // guard
+
+ 
+  
+
+
+`line 19 "inc3_a_filename_from_line_directive" 2
+`line 5 "verilog/inc2.v" 0
+
+  
+`line 7 "verilog/inc2.v" 2